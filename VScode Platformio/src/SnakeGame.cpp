@@ -1,5 +1,7 @@
 #include "SnakeGame.h"
 #include <Arduino.h>
+#include "app.h"
+#include "snakecore.h"
 
 // Pull in your OLED instance from main .ino
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
@@ -11,15 +13,13 @@ extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 #define BUTTON_RIGHT_PIN  27
 #define BUTTON_SELECT_PIN 32
 
-// Grid config
-static const int cellSize   = 4;
-static const int gridWidth  = 128 / cellSize;
-static const int gridHeight =  64 / cellSize;
+// Grid config: the 32x16 board of snakecore.h in 4 px cells; a cell never
+// straddles one of the display's 8x8 tiles
+static const int cellSize = 4;
 
 // Snake/game state
-static int snakeX[128], snakeY[128], snakeLength;
-static int dirX, dirY;
-static int foodX, foodY;
+static SnakeState snake;
+static bool fullRedraw = true;   // otherwise only the cells the last step changed are sent
 
 // Timing
 static unsigned long lastMove     = 0;
@@ -28,42 +28,52 @@ static const unsigned long moveInterval = 100;
 // Pause & menu navigation
 static bool paused = false;
 static int  pauseIndex = 0;                          // 0=Resume, 1=Toggle Diff, 2=Exit
-static unsigned long lastBtnTime = 0;
-static const unsigned long debounceDelay = 200;
 
 // Difficulty
 Difficulty gameDifficulty = HARD;
 
-// Place food off the snake and never at (0,0)
-static void placeFood() {
-  bool conflict;
-  do {
-    conflict = false;
-    foodX = random(0, gridWidth);
-    foodY = random(0, gridHeight);
-    if (foodX == 0 && foodY == 0) conflict = true;
-    for (int i = 0; !conflict && i < snakeLength; i++) {
-      if (snakeX[i] == foodX && snakeY[i] == foodY) conflict = true;
-    }
-  } while (conflict);
+static void newGame() {
+  snakeReset(snake, esp_random(), gameDifficulty == EASY);
+  fullRedraw = true;
 }
 
 void setupSnakeGame() {
-  snakeLength = 3;
-  snakeX[0] = gridWidth/2;
-  snakeY[0] = gridHeight/2;
-  dirX = 1; dirY = 0;
-  placeFood();
+  newGame();
   paused = false;
   pauseIndex = 0;
 }
 
-// Check self‐collision
-static bool checkSelf() {
-  for (int i = 1; i < snakeLength; i++) {
-    if (snakeX[0] == snakeX[i] && snakeY[0] == snakeY[i]) return true;
+static void drawCell(uint16_t cell, uint8_t color) {
+  u8g2.setDrawColor(color);
+  u8g2.drawBox(snakeCellX(cell) * cellSize, snakeCellY(cell) * cellSize, cellSize, cellSize);
+  u8g2.setDrawColor(1);
+}
+
+// Sends just the 8x8 tile holding the cell: 8 bytes instead of the full 1 KB frame
+static void sendCell(uint16_t cell) {
+  u8g2.updateDisplayArea(snakeCellX(cell) * cellSize / 8, snakeCellY(cell) * cellSize / 8, 1, 1);
+}
+
+static void drawBoard() {
+  u8g2.clearBuffer();
+  for (int i = 0; i < snake.length; i++) drawCell(snakeSegment(snake, i), 1);
+  if (snake.food != SNAKE_NONE) drawCell(snake.food, 1);
+  u8g2.sendBuffer();
+  fullRedraw = false;
+}
+
+// After a step: the tail cell it left, the new head, and new food
+static void drawStep() {
+  if (snake.vacated != SNAKE_NONE) {
+    drawCell(snake.vacated, 0);
+    sendCell(snake.vacated);
+  }
+  drawCell(snake.newHead, 1);
+  sendCell(snake.newHead);
+  if (snake.newFood != SNAKE_NONE) {
+    drawCell(snake.newFood, 1);
+    sendCell(snake.newFood);
   }
-  return false;
 }
 
 // Draw the pause menu centrally aligned
@@ -74,6 +84,8 @@ static void drawPauseMenu() {
     "Exit to Menu"
   };
 
+  if (!appRedraw()) return;
+
   u8g2.clearBuffer();
   u8g2.setFont(u8g2_font_ncenB08_tr);
 
@@ -109,98 +121,68 @@ static void drawPauseMenu() {
   u8g2.sendBuffer();
 }
 
-// Run one frame. Returns true if "Exit to Menu" was selected.
-bool loopSnakeGame() {
+static bool steer(uint8_t pin) {
+  return appPressed(pin) || appHeld(pin);
+}
+
+// Run one frame. "Exit to Menu" leaves through appExit().
+void loopSnakeGame() {
   unsigned long now = millis();
 
-  // Debounced SELECT press: enter/operate pause menu
-  if (digitalRead(BUTTON_SELECT_PIN) == LOW && now - lastBtnTime > debounceDelay) {
-    lastBtnTime = now;
+  // SELECT press: enter/operate pause menu
+  if (appPressed(BUTTON_SELECT_PIN)) {
     if (!paused) {
       // enter pause
       paused = true;
       pauseIndex = 0;
-      return false;
+      return;
     } else {
       // select the highlighted pause‐menu item
       switch (pauseIndex) {
         case 0: // Resume
           paused = false;
+          snake.wrap = gameDifficulty == EASY;
+          fullRedraw = true;
           break;
         case 1: // Toggle difficulty
           gameDifficulty = (gameDifficulty == EASY ? HARD : EASY);
           break;
         case 2: // Exit
-          return true;
+          appExit();
+          break;
       }
-      return false;
+      return;
     }
   }
 
   // If paused, handle UP/DOWN navigation and redraw menu
   if (paused) {
-    if (digitalRead(BUTTON_UP_PIN) == LOW && now - lastBtnTime > debounceDelay) {
+    if (appPressed(BUTTON_UP_PIN)) {
       pauseIndex = (pauseIndex + 2) % 3;
-      lastBtnTime = now;
     }
-    if (digitalRead(BUTTON_DOWN_PIN) == LOW && now - lastBtnTime > debounceDelay) {
+    if (appPressed(BUTTON_DOWN_PIN)) {
       pauseIndex = (pauseIndex + 1) % 3;
-      lastBtnTime = now;
     }
     drawPauseMenu();
-    return false;
+    return;
   }
 
-  // Normal movement
-  if      (digitalRead(BUTTON_UP_PIN)    == LOW && dirY == 0) { dirX = 0; dirY = -1; }
-  else if (digitalRead(BUTTON_DOWN_PIN)  == LOW && dirY == 0) { dirX = 0; dirY =  1; }
-  else if (digitalRead(BUTTON_LEFT_PIN)  == LOW && dirX == 0) { dirX = -1; dirY = 0; }
-  else if (digitalRead(BUTTON_RIGHT_PIN) == LOW && dirX == 0) { dirX =  1; dirY = 0; }
+  // Normal movement (a tap shorter than a frame counts too)
+  (steer(BUTTON_UP_PIN)    && snakeSteer(snake, SNAKE_UP))   ||
+  (steer(BUTTON_DOWN_PIN)  && snakeSteer(snake, SNAKE_DOWN)) ||
+  (steer(BUTTON_LEFT_PIN)  && snakeSteer(snake, SNAKE_LEFT)) ||
+  (steer(BUTTON_RIGHT_PIN) && snakeSteer(snake, SNAKE_RIGHT));
 
-  // Advance game tick
+  // Advance game tick; a lost or won game starts over
+  bool stepped = false;
   if (now - lastMove > moveInterval) {
     lastMove = now;
-    for (int i = snakeLength - 1; i > 0; i--) {
-      snakeX[i] = snakeX[i - 1];
-      snakeY[i] = snakeY[i - 1];
-    }
-    snakeX[0] += dirX;
-    snakeY[0] += dirY;
-
-    // wall behavior
-    if (gameDifficulty == EASY) {
-      if (snakeX[0] < 0)               snakeX[0] = gridWidth - 1;
-      else if (snakeX[0] >= gridWidth) snakeX[0] = 0;
-      if (snakeY[0] < 0)               snakeY[0] = gridHeight - 1;
-      else if (snakeY[0] >= gridHeight)snakeY[0] = 0;
-    } else {
-      if (snakeX[0] < 0 || snakeX[0] >= gridWidth ||
-          snakeY[0] < 0 || snakeY[0] >= gridHeight) {
-        setupSnakeGame();
-        return false;
-      }
-    }
-
-    // self‐collision
-    if (checkSelf()) {
-      setupSnakeGame();
-      return false;
-    }
-
-    // food collision
-    if (snakeX[0] == foodX && snakeY[0] == foodY) {
-      if (snakeLength < 128) snakeLength++;
-      placeFood();
-    }
+    SnakeEvent ev = snakeStep(snake);
+    if (ev == SNAKE_DIED || ev == SNAKE_WON) newGame();
+    else stepped = true;
   }
 
   // draw snake & food
-  u8g2.clearBuffer();
-  for (int i = 0; i < snakeLength; i++) {
-    u8g2.drawBox(snakeX[i] * cellSize, snakeY[i] * cellSize, cellSize, cellSize);
-  }
-  u8g2.drawBox(foodX * cellSize, foodY * cellSize, cellSize, cellSize);
-  u8g2.sendBuffer();
-
-  return false;
+  if (fullRedraw) drawBoard();
+  else if (stepped) drawStep();
 }
@@ -12,7 +12,7 @@ extern Difficulty gameDifficulty;
 void setupSnakeGame();
 
 // Run one frame.  
-// Returns true if the player long‐pressed SELECT (i.e. requests exit to menu).
-bool loopSnakeGame();
+// "Exit to Menu" in the pause menu returns to the main menu via appExit().
+void loopSnakeGame();
 
 #endif // SNAKEGAME_H
@@ -6,6 +6,14 @@
 #include <Arduino.h> 
 #include "analyzer.h"
 #include "setting.h"
+#include "app.h"
+#include "diag.h"
+#include "cli.h"
+#include "config.h"
+#include "raster.h"
+#include "neopixel.h"
+#include "nrfbus.h"
+#include "rpdlevel.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -21,29 +29,50 @@ extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 #define N 128
 uint8_t values[N];
 
+// Peak hold: the highest bar top of recent sweeps, sinking PEAK_DECAY rows
+// per sweep until the bars reach it again
+#define BAR_BOTTOM  54
+#define PEAK_DECAY  2
+static int8_t peakTop[N];
+
 #define CE  5
-#define CSN 17
+
+#define BUTTON_UP_PIN     26
+#define BUTTON_DOWN_PIN   33
+#define BUTTON_LEFT_PIN   25
+#define BUTTON_RIGHT_PIN  27
 
 #define CHANNELS  64
 int CHannel[CHANNELS];
 
+// 50 passes over 128 channels take ~1 s, so the sweep is spread over frames
+uint8_t analyzerPasses = 50;   // set from the console
+static int sweepPass = 0;
+static int sweepChannel = 0;
 
-byte getregister(byte r) {
-  byte c;
+// Span/zoom: only channels [center - span / 2, + span) are swept, so a
+// narrow view refreshes in proportion faster. Fixed for a sweep once it starts.
+uint8_t analyzerCenter = 64;   // set from the console and LEFT/RIGHT
+uint8_t analyzerSpan = N;      // ... and UP/DOWN
+static int sweepFirst = 0;
+static int sweepSpan = N;
+static int sweepPasses = 50;
 
-  digitalWrite(CSN, LOW);
-  SPI.transfer(r & 0x1F);
-  c = SPI.transfer(0);
-  digitalWrite(CSN, HIGH);
+// Level mode (rpdlevel.h): the passes take turns over the RF_SETUP steps,
+// one register write per pass, and the bars show the estimated dBm
+uint8_t analyzerLevels = 0;    // set from the console
+#define LEVEL_FLOOR  -88       // dBm at the bar bottom, one pixel per dB above
+static uint8_t stepHits[N][RPD_STEPS];
+static uint8_t stepSamples[RPD_STEPS];
+static int sweepStep = 0;
 
-  return c;
+
+byte getregister(byte r) {
+  return nrfRead(NRF_RADIO_A, r);
 }
 
 void setregister(byte r, byte v) {
-  digitalWrite(CSN, LOW);
-  SPI.transfer((r & 0x1F) | 0x20);
-  SPI.transfer(v);
-  digitalWrite(CSN, HIGH);
+  nrfWrite(NRF_RADIO_A, r, v);
 }
 
 void powerup(void) {
@@ -84,18 +113,11 @@ void ScanChannels(void) {
 
 
 void writeRegister(uint8_t reg, uint8_t value) {
-    digitalWrite(CSN, LOW);
-    SPI.transfer(reg | 0x20);
-    SPI.transfer(value);
-    digitalWrite(CSN, HIGH);
+    nrfWrite(NRF_RADIO_A, reg, value);
 }
 
 uint8_t readRegister(uint8_t reg) {
-    digitalWrite(CSN, LOW);
-    SPI.transfer(reg & 0x1F);
-    uint8_t result = SPI.transfer(0x00);
-    digitalWrite(CSN, HIGH);
-    return result;
+    return nrfRead(NRF_RADIO_A, reg);
 }
 
 void setChannel(uint8_t CHannel) {
@@ -130,64 +152,177 @@ void analyzerSetup(){
   
     Serial.begin(115200);
     
-    esp_bt_controller_deinit();
-    esp_wifi_stop();
-    esp_wifi_deinit();
-  
     pinMode(CE, OUTPUT);
-    pinMode(CSN, OUTPUT);
 
-    SPI.begin(18, 19, 23, 17);
-    SPI.setDataMode(SPI_MODE0);
-    SPI.setFrequency(10000000);
-    SPI.setBitOrder(MSBFIRST);
+    nrfBusClock(NRF_RADIO_A, 10000000);
+    nrfBusBegin();
 
-    digitalWrite(CSN, HIGH);
     digitalWrite(CE, LOW);
 
     DIsable();
 
-    powerUP();
-    writeRegister(NRF24_EN_AA, 0x00);
-    writeRegister(NRF24_RF_SETUP, 0x0F);  
+    NrfBatch batch;
+    nrfBatchClear(batch);
+    nrfBatchWrite(batch, NRF24_CONFIG, readRegister(NRF24_CONFIG) | 0x02);
+    nrfBatchWrite(batch, NRF24_EN_AA, 0x00);
+    nrfBatchWrite(batch, NRF24_RF_SETUP, 0x0F);
+    nrfBatchRun(NRF_RADIO_A, batch);
+    delay(5);
 
+    sweepPass = 0;
+    sweepChannel = 0;
+    memset(peakTop, BAR_BOTTOM, sizeof(peakTop));
 }
 
-void analyzerLoop(){
+// Channels [first, first + span) around analyzerCenter
+static void viewRange(int &first, int &span) {
+    span = constrain((int)analyzerSpan, 1, N);
+    first = constrain((int)analyzerCenter - span / 2, 0, N - span);
+}
 
-    ScanChannels();
+// Zoom steps for UP/DOWN; the console takes any span
+static const uint8_t spans[] = { 128, 64, 32, 20, 10 };
+static const int spanCount = sizeof(spans) / sizeof(spans[0]);
 
-    memset(values, 0, sizeof(values));
+static void restartSweep() {
+    sweepPass = 0;
+    sweepChannel = 0;
+    memset(peakTop, BAR_BOTTOM, sizeof(peakTop));
+    configChanged();
+}
 
-    int n = 50;
-    while (n--) {
-        int i = N;
-        while (i--) {
-            setChannel(i);
-            startListening();
-            delayMicroseconds(128);
-            stopListening();
-            if (carrierDetected()) {
-                ++values[i];
-            }
+static void handleButtons() {
+    int zoom = 0;
+    while (zoom < spanCount - 1 && spans[zoom] > analyzerSpan) zoom++;
+
+    if (appPressed(BUTTON_UP_PIN) && analyzerSpan > spans[spanCount - 1]) {
+        // from a console span that is not in the list, UP goes to the next one down
+        analyzerSpan = spans[spans[zoom] < analyzerSpan ? zoom : zoom + 1];
+        restartSweep();
+    }
+    if (appPressed(BUTTON_DOWN_PIN) && analyzerSpan < N) {
+        analyzerSpan = zoom > 0 ? spans[zoom - 1] : N;
+        restartSweep();
+    }
+    if (analyzerSpan == N) return;
+
+    // one channel per press, repeating while held
+    int first, span;
+    viewRange(first, span);
+    if (appPressedRepeat(BUTTON_LEFT_PIN) && first > 0) {
+        analyzerCenter = first - 1 + span / 2;
+        restartSweep();
+    }
+    if (appPressedRepeat(BUTTON_RIGHT_PIN) && first + span < N) {
+        analyzerCenter = first + 1 + span / 2;
+        restartSweep();
+    }
+}
+
+// Channel numbers under the bars: a 1-2-5 step that fits about five labels
+static void drawAxis(int first, int span) {
+    if (span == N) {
+        u8g2.setFont(u8g2_font_ncenB08_tr);
+        u8g2.setCursor(0, 64);
+        u8g2.print("1...5...10...25..50...80...128");
+        return;
+    }
+
+    static const uint8_t steps[] = { 1, 2, 5, 10, 20, 50 };
+    int step = steps[0];
+    for (uint8_t s : steps) {
+        step = s;
+        if (span / s <= 5) break;
+    }
+
+    char label[4];
+    u8g2.setFont(u8g2_font_5x8_tr);
+    for (int ch = (first + step - 1) / step * step; ch < first + span; ch += step) {
+        int len = snprintf(label, sizeof(label), "%d", ch);
+        int x = ((ch - first) * 2 + 1) * N / (span * 2) - len * 5 / 2;
+        u8g2.drawStr(constrain(x, 0, SCREEN_WIDTH - len * 5), 64, label);
+    }
+}
+
+void analyzerLoop(){
+
+    handleButtons();
+
+    nrfBusAcquire(NRF_RADIO_A);
+    if (sweepPass == 0 && sweepChannel == 0) {
+        viewRange(sweepFirst, sweepSpan);
+        // a zoomed sweep spends some of the time it saves on more passes
+        sweepPasses = sweepSpan == N ? analyzerPasses : min(255, analyzerPasses * 5 / 4);
+        if (sweepSpan == N) ScanChannels();
+        else setregister(NRF24_CONFIG, getregister(NRF24_CONFIG) | 0x01);   // PRIM_RX, as the warm-up pass leaves it
+        memset(values, 0, sizeof(values));
+        memset(stepHits, 0, sizeof(stepHits));
+        memset(stepSamples, 0, sizeof(stepSamples));
+    }
+
+    while (sweepPass < sweepPasses && appBudgetLeft()) {
+        DIAG_SCOPE("analyzer channel");
+        if (analyzerLevels && sweepChannel == 0) {
+            sweepStep = sweepPass % RPD_STEPS;
+            writeRegister(NRF24_RF_SETUP, rpdSteps[sweepStep].rfSetup);
+            stepSamples[sweepStep]++;
+        }
+        int i = sweepFirst + sweepSpan - 1 - sweepChannel;
+        setChannel(i);
+        startListening();
+        delayMicroseconds(128);
+        stopListening();
+        if (carrierDetected()) {
+            ++values[i];
+            if (analyzerLevels) ++stepHits[i][sweepStep];
+        }
+        if (++sweepChannel == sweepSpan) {
+            sweepChannel = 0;
+            sweepPass++;
         }
     }
+    if (sweepPass == sweepPasses) writeRegister(NRF24_RF_SETUP, 0x0F);
+    nrfBusRelease(NRF_RADIO_A);
+    if (sweepPass < sweepPasses) return;
+    sweepPass = 0;
+
+    if (cliStreaming()) cliStream(CLI_STREAM_ANALYZER, values, N);
+
+    uint8_t busiest = 0;
+    for (int i = 0; i < N; ++i) busiest = max(busiest, values[i]);
+    ledLevel(busiest * 100 / sweepPasses);
 
     u8g2.clearBuffer();
-    int barWidth = SCREEN_WIDTH / N;
-    int x = 0;
-    for (int i = 0; i < N; ++i) {
-        int v = 63 - values[i] * 3;
-        if (v < 0) {
-            v = 0;
+    {
+        DIAG_SCOPE("analyzer draw");
+        uint8_t *buffer = u8g2.getBufferPtr();
+        int level = RPD_QUIET;
+        for (int i = 0; i < N; ++i) {
+            // zoomed, a channel is N / span columns wide with a gap on its right
+            int ch = sweepFirst + i * sweepSpan / N;
+            bool gap = sweepSpan <= 32 && (i + 1) * sweepSpan / N != i * sweepSpan / N;
+            bool first = i == 0 || (i - 1) * sweepSpan / N != i * sweepSpan / N;
+
+            // hits as a share of the passes, 3 pixels per hit at the configured count
+            int v = 63 - values[ch] * 3 * analyzerPasses / sweepPasses;
+            if (v < 0) {
+                v = 0;
+            }
+            int top = v - 10;
+            if (analyzerLevels) {
+                if (first) level = rpdEstimate(stepHits[ch], stepSamples);
+                top = level == RPD_QUIET ? BAR_BOTTOM : max(0, BAR_BOTTOM - (level - LEVEL_FLOOR));
+            }
+            if (gap) top = BAR_BOTTOM;
+            rasterColumn<RasterSolid>(buffer, i, top, BAR_BOTTOM);
+
+            if (top < peakTop[i]) peakTop[i] = top;
+            else peakTop[i] = min(top, peakTop[i] + PEAK_DECAY);
+            if (peakTop[i] < top - 1) rasterColumn<RasterPeak>(buffer, i, peakTop[i], BAR_BOTTOM);
         }
-        u8g2.drawVLine(x, v - 10, 64 - v);
-        x += barWidth;
     }
 
-    u8g2.setFont(u8g2_font_ncenB08_tr);
-    u8g2.setCursor(0, 64);
-    u8g2.print("1...5...10...25..50...80...128");
+    drawAxis(sweepFirst, sweepSpan);
     u8g2.sendBuffer();
 
     //delay(50);  
@@ -11,6 +11,11 @@
 #include "esp_bt.h"
 #include "esp_wifi.h"
 
+extern uint8_t analyzerPasses;
+extern uint8_t analyzerLevels;
+extern uint8_t analyzerCenter;
+extern uint8_t analyzerSpan;
+
 void analyzerSetup();
 void analyzerLoop();
 
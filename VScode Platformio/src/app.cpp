@@ -0,0 +1,287 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "app.h"
+#include "resources.h"
+#include "input.h"
+#include "diag.h"
+#include "cli.h"
+#include "power.h"
+#include "config.h"
+#include "neopixel.h"
+#include "journal.h"
+#include "nrfbus.h"
+
+#define BUTTON_UP_PIN     26
+#define BUTTON_DOWN_PIN   33
+#define BUTTON_LEFT_PIN   25
+#define BUTTON_RIGHT_PIN  27
+#define BUTTON_SELECT_PIN 32
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+static const uint8_t buttonPins[] = {
+  BUTTON_UP_PIN, BUTTON_DOWN_PIN, BUTTON_LEFT_PIN, BUTTON_RIGHT_PIN, BUTTON_SELECT_PIN
+};
+static const int buttonCount = sizeof(buttonPins) / sizeof(buttonPins[0]);
+
+// button state for this frame, built from the input events
+static bool held[buttonCount];
+static bool pressed[buttonCount];
+static bool released[buttonCount];
+static bool longPressed[buttonCount];
+static bool repeated[buttonCount];
+static bool swallowed[buttonCount];  // pressed to wake the display, ignored until released
+
+static const App *home = nullptr;
+static const App *current = nullptr;
+static const App *pending = nullptr;
+
+static uint32_t tickStartUs = 0;
+
+// frame statistics of the running app, reported when it exits
+static uint32_t frames = 0;
+static uint32_t overruns = 0;
+static uint32_t worstUs = 0;
+static uint32_t worstInputMs = 0;    // edge to the frame that saw it
+static uint32_t busyUs = 0;          // sum of tick times
+static uint32_t redraws = 0;
+static uint32_t appStartUs = 0;
+static uint32_t i2cStartBytes = 0;
+static uint32_t steadyAllocs = 0;    // heap allocations in ticks after the warm-up (ALLOC_PROBE)
+
+// the first second after enter (scan start, driver callbacks) is not steady state
+#define ALLOC_WARMUP_FRAMES (1000 / APP_FRAME_MS)
+
+// redraw requests of the running app
+static bool dirty = false;
+static bool redrawTimed = false;
+static uint32_t redrawAtMs = 0;
+
+// display bus traffic, counted in the u8x8 byte layer
+static u8x8_msg_cb i2cByteCb = nullptr;
+static volatile uint32_t i2cBytes = 0;
+
+static uint8_t countingByteCb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
+  if (msg == U8X8_MSG_BYTE_SEND) i2cBytes += arg_int;
+  return i2cByteCb(u8x8, msg, arg_int, arg_ptr);
+}
+
+static int buttonSlot(uint8_t pin) {
+  for (int i = 0; i < buttonCount; i++) {
+    if (buttonPins[i] == pin) return i;
+  }
+  return -1;
+}
+
+static void readInput() {
+  for (int i = 0; i < buttonCount; i++) {
+    pressed[i] = false;
+    released[i] = false;
+    longPressed[i] = false;
+    repeated[i] = false;
+  }
+
+  // a tap shorter than a frame still shows up as a press
+  uint32_t now = millis();
+  InputEvent ev;
+  while (inputPoll(ev)) {
+    int i = buttonSlot(ev.pin);
+    if (i < 0) continue;
+    if (now - ev.ms > worstInputMs) worstInputMs = now - ev.ms;
+    if (ev.type == INPUT_PRESS && powerUserActivity()) swallowed[i] = true;
+    if (swallowed[i]) {
+      if (ev.type == INPUT_RELEASE) swallowed[i] = false;
+      dirty = true;   // the display is back on, show the current state
+      continue;
+    }
+    dirty = true;     // most screen state changes come from buttons
+    switch (ev.type) {
+      case INPUT_PRESS:   pressed[i] = true; held[i] = true; break;
+      case INPUT_RELEASE: released[i] = true; held[i] = false; break;
+      case INPUT_LONG:    longPressed[i] = true; break;
+      case INPUT_REPEAT:  repeated[i] = true; break;
+    }
+  }
+}
+
+static void switchApp() {
+  const App *next = pending;
+  pending = nullptr;
+
+  ResTransition t;
+  t.app = next->name;
+  t.freeBefore = resFreeHeap();
+
+  if (current) {
+    if (current->exit) current->exit();
+    if (current != home) {
+      uint32_t elapsedUs = micros() - appStartUs;
+      uint32_t elapsedMs = elapsedUs / 1000 ? elapsedUs / 1000 : 1;
+      Serial.printf("app %s: %u frames, %u over %u ms, worst tick %u us, worst input %u ms\n",
+                    current->name, (unsigned)frames, (unsigned)overruns,
+                    APP_FRAME_MS, (unsigned)worstUs, (unsigned)worstInputMs);
+      Serial.printf("app %s: %u redraws, idle %u%%, i2c %u B/s\n",
+                    current->name, (unsigned)redraws,
+                    (unsigned)(elapsedUs > busyUs ? (uint64_t)(elapsedUs - busyUs) * 100 / elapsedUs : 0),
+                    (unsigned)((uint64_t)(i2cBytes - i2cStartBytes) * 1000 / elapsedMs));
+#if ALLOC_PROBE
+      Serial.printf("app %s: %u heap allocations in %u steady frames\n", current->name,
+                    (unsigned)steadyAllocs,
+                    (unsigned)(frames > ALLOC_WARMUP_FRAMES ? frames - ALLOC_WARMUP_FRAMES : 0));
+#endif
+    }
+  }
+
+  frames = 0;
+  overruns = 0;
+  worstUs = 0;
+  worstInputMs = 0;
+  busyUs = 0;
+  redraws = 0;
+  steadyAllocs = 0;
+  dirty = true;
+  redrawTimed = false;
+
+  // the LED background belongs to the screen, the next one sets its own
+  ledClear();
+
+  // VSPI goes back to the Arduino driver, a sweeper takes it again in its setup
+  nrfBusEnd();
+
+  // release first so drivers the next app does not use free their heap
+  t.releaseUs = resRelease(next->resources);
+  t.acquireUs = resAcquire(next->resources);
+
+  current = next;
+  uint32_t enterStart = micros();
+  if (current->enter) current->enter();
+  t.enterUs = micros() - enterStart;
+
+  t.held = resHeld();
+  t.freeAfter = resFreeHeap();
+  t.largestAfter = resLargestBlock();
+  resRecord(t);
+  journalScreen(next->name, t.freeAfter, t.largestAfter);
+  ledStatus(t.freeAfter < RES_LOW_HEAP ? LED_LOW_MEMORY : LED_MEMORY_OK);
+
+  appStartUs = micros();
+  i2cStartBytes = i2cBytes;
+}
+
+void appSetup(const App &homeApp) {
+  inputSetup(buttonPins, buttonCount);
+  powerSetup();
+  diagAllocWatch();
+
+  u8x8_t *u8x8 = u8g2.getU8x8();
+  i2cByteCb = u8x8->byte_cb;
+  u8x8->byte_cb = countingByteCb;
+
+  home = &homeApp;
+  current = nullptr;
+  pending = home;
+  switchApp();
+}
+
+void appRun() {
+  tickStartUs = micros();
+  readInput();
+  cliFrame();     // console commands that switch screens or change settings
+  configFrame();  // settings commit once they have been quiet for a while
+
+  const App *app = current;
+#if ALLOC_PROBE
+  uint32_t allocsBefore = diagAllocs();
+  app->tick();
+  if (frames >= ALLOC_WARMUP_FRAMES) steadyAllocs += diagAllocs() - allocsBefore;
+#else
+  app->tick();
+#endif
+
+  // SELECT leaves every screen that does not handle it itself
+  if (!pending && app != home && !(app->flags & APP_OWNS_SELECT) && appPressed(BUTTON_SELECT_PIN)) {
+    appExit();
+  }
+
+  uint32_t usedUs = micros() - tickStartUs;
+  frames++;
+  busyUs += usedUs;
+  if (diagOn) diagFrame(app->name, usedUs);
+  journalFrame(app->name, usedUs);
+  if (usedUs > worstUs) worstUs = usedUs;
+  if (usedUs > APP_FRAME_MS * 1000UL) overruns++;
+
+  if (pending) switchApp();
+  powerFrame(resHeld(), current->flags);
+
+  // sleep out the rest of the frame; always yields at least one tick
+  uint32_t restMs = usedUs < APP_FRAME_MS * 1000UL ? (APP_FRAME_MS * 1000UL - usedUs) / 1000 : 0;
+  powerWait(restMs);
+}
+
+void appStart(const App &app) {
+  pending = &app;
+}
+
+void appExit() {
+  pending = home;
+}
+
+const App &appCurrent() {
+  return *current;
+}
+
+void appInvalidate() {
+  dirty = true;
+}
+
+void appInvalidateIn(uint32_t ms) {
+  uint32_t at = millis() + ms;
+  if (!redrawTimed || (int32_t)(at - redrawAtMs) < 0) redrawAtMs = at;
+  redrawTimed = true;
+}
+
+bool appRedraw() {
+  if (redrawTimed && (int32_t)(millis() - redrawAtMs) >= 0) {
+    redrawTimed = false;
+    dirty = true;
+  }
+  if (!dirty || powerDisplayOff()) return false;
+  dirty = false;
+  redraws++;
+  return true;
+}
+
+bool appBudgetLeft() {
+  return micros() - tickStartUs < APP_TICK_BUDGET_US;
+}
+
+bool appPressed(uint8_t pin) {
+  int i = buttonSlot(pin);
+  return i >= 0 && pressed[i];
+}
+
+bool appReleased(uint8_t pin) {
+  int i = buttonSlot(pin);
+  return i >= 0 && released[i];
+}
+
+bool appHeld(uint8_t pin) {
+  int i = buttonSlot(pin);
+  return i >= 0 && held[i];
+}
+
+bool appLongPressed(uint8_t pin) {
+  int i = buttonSlot(pin);
+  return i >= 0 && longPressed[i];
+}
+
+bool appPressedRepeat(uint8_t pin) {
+  int i = buttonSlot(pin);
+  return i >= 0 && (pressed[i] || repeated[i]);
+}
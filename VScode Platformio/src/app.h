@@ -0,0 +1,78 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef app_H
+#define app_H
+
+#include <stdint.h>
+
+struct TileImage;
+
+// Cooperative screen runtime.
+//
+// Every screen is an App with enter/tick/exit hooks. loop() calls appRun(),
+// which runs exactly one tick of the current app per frame. A tick must never
+// block: long jobs (channel sweeps, scans) are split across frames and use
+// appBudgetLeft() to decide how much work fits into the current one.
+// Leftover frame time is slept away so the idle task and watchdog get to run,
+// in light sleep once the power manager has switched the display off.
+
+// A full 1 KB frame over 400 kHz I2C takes ~25 ms, which sets the frame rate
+#define APP_FRAME_MS        40      // frame period, caps the UI at 25 fps
+#define APP_TICK_BUDGET_US  12000   // work a tick may do before drawing and yielding
+
+// App flags
+#define APP_OWNS_SELECT     0x01    // SELECT is not the exit button; the app calls appExit()
+#define APP_KEEP_AWAKE      0x02    // live display: never dimmed or switched off (power.h)
+#define APP_DUTY_CYCLED     0x04    // radios powered down between bursts, light sleep allowed
+
+struct App {
+  const char *name;
+  const TileImage *icon;            // 16x16 menu icon (icon_tiles.h), may be nullptr
+  void (*enter)();
+  void (*tick)();
+  void (*exit)();
+  uint8_t resources;                // RES_* the app needs, see resources.h
+  uint8_t flags;
+};
+
+// Apps may assume everything in their resource set is held in all hooks.
+// Each switch is recorded in the resources history.
+
+// The home app (the menu) is where appExit() returns to
+void appSetup(const App &home);
+void appRun();
+
+// Switches take effect at the end of the current frame: the running app's
+// exit hook runs before the next app's enter hook.
+void appStart(const App &app);
+void appExit();
+const App &appCurrent();
+
+// Redraw model. A screen that only changes on input or on events draws
+// inside `if (appRedraw())` and otherwise leaves the display alone, so a
+// static screen costs neither CPU nor I2C time. The runtime invalidates on
+// enter and on every button event; background changes call appInvalidate(),
+// and timed content (a clock, a "lost" marker) asks for appInvalidateIn().
+// At most one redraw happens per frame, which caps it at the frame rate.
+// While the power manager has the display off, redraws are held back.
+// Screens that animate every frame keep drawing unconditionally.
+void appInvalidate();
+void appInvalidateIn(uint32_t ms);
+bool appRedraw();
+
+// True while the current tick still has time left in its budget
+bool appBudgetLeft();
+
+// Button state for this frame, taken from the input.h event queue at the
+// start of the frame (pins are active low)
+bool appPressed(uint8_t pin);
+bool appReleased(uint8_t pin);
+bool appHeld(uint8_t pin);
+bool appLongPressed(uint8_t pin);
+// Press, or auto-repeat while the button stays down (list navigation)
+bool appPressedRepeat(uint8_t pin);
+
+#endif
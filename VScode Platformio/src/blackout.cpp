@@ -5,7 +5,8 @@
 
 #include <Arduino.h>
 #include "blackout.h"
-#include "icon.h"
+#include "icon_tiles.h"
+#include "app.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -47,41 +48,6 @@ const byte rc_channels[] =               {1, 3, 5, 7};
 const byte zigbee_channels[] =           {11, 15, 20, 25};
 const byte nrf24_channels[] =            {76, 78, 79};
 
-volatile bool ChangeRequested = false;
-volatile bool ChangeRequested1 = false;
-volatile bool ChangeRequested2 = false;
-
-unsigned long lastPressTime = 0;
-const unsigned long debounceDelay = 200;
-
-
-void IRAM_ATTR handleButton() {
-  unsigned long currentTime = millis();
-  if (currentTime - lastPressTime > debounceDelay) {
-    ChangeRequested = true;
-    lastPressTime = currentTime;
-  }
-}
-
-void IRAM_ATTR handleButton1() {
-  unsigned long currentTime = millis();
-  if (currentTime - lastPressTime > debounceDelay) {
-    ChangeRequested1 = true;
-    lastPressTime = currentTime;
-  }
-}
-
-void IRAM_ATTR handleButton2() {
-  unsigned long currentTime = millis();
-  if (currentTime - lastPressTime > debounceDelay) {
-    if (current == DEACTIVE_MODE) {
-      current = ACTIVE_MODE;  
-    } else {
-      current = DEACTIVE_MODE;  
-    }
-    lastPressTime = currentTime;  
-  }
-}
 
 void configure_Radio(RF24 &radio, const byte *channels, size_t size) {
   radio.setAutoAck(false);
@@ -117,7 +83,6 @@ void initialize_Radios() {
     radio_1.powerDown();
     radio_2.powerDown();
     radio_3.powerDown();
-    delay(100);  
   }
 }
 
@@ -138,40 +103,40 @@ void update_OLED() {
   //u8g2.print("Mode: ");
   u8g2.print("[");
 
-  u8g2.drawXBMP(0, 5, 128, 64, bitmap_arrow_left);
-  u8g2.drawXBMP(0, 5, 128, 64, bitmap_arrow_right);
+  tileDraw(tile_arrow_left, 0, 5);
+  tileDraw(tile_arrow_right, 0, 5);
   
   switch (current_Mode) {
     case WiFi_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_wifi_jammer);
+        tileDraw(tile_wifi_jammer, 0, 5);
         u8g2.print("WiFi");
         break;
     case VIDEO_TX_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_cctv);
+        tileDraw(tile_cctv, 0, 5);
         u8g2.print("Video TX");
         break;
     case RC_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_rc);
+        tileDraw(tile_rc, 0, 5);
         u8g2.print("RC");
         break;
     case BLE_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_ble_jammer);
+        tileDraw(tile_ble_jammer, 0, 5);
         u8g2.print("BLE");
         break;
     case Bluetooth_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_bluetooth_jammer);
+        tileDraw(tile_bluetooth_jammer, 0, 5);
         u8g2.print("Bluetooth");
         break;
     case USB_WIRELESS_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_usb);
+        tileDraw(tile_usb, 0, 5);
         u8g2.print("USB Wireless");
         break;
     case ZIGBEE_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_zigbee);
+        tileDraw(tile_zigbee, 0, 5);
         u8g2.print("Zigbee");
         break;
     case NRF24_MODULE:
-        u8g2.drawXBMP(0, 5, 128, 64, bitmap_nrf24);
+        tileDraw(tile_nrf24, 0, 5);
         u8g2.print("NRF24");
         break;
  }
@@ -179,13 +144,16 @@ void update_OLED() {
   u8g2.sendBuffer();
 }
 
+// Buttons arrive through the app runtime's input queue (input.h)
 void checkMode() {
-  if (ChangeRequested) {
-    ChangeRequested = false;
+  if (appPressed(MODE_BUTTON2)) {
+    current = (current == DEACTIVE_MODE) ? ACTIVE_MODE : DEACTIVE_MODE;
+  }
+
+  if (appPressed(MODE_BUTTON)) {
     current_Mode = static_cast<OperationMode>((current_Mode == 0) ? 7 : (current_Mode - 1));
     update_OLED();
-  } else if (ChangeRequested1) {
-    ChangeRequested1 = false;
+  } else if (appPressed(MODE_BUTTON1)) {
     current_Mode = static_cast<OperationMode>((current_Mode + 1) % 8);     
     update_OLED();
   }
@@ -194,22 +162,15 @@ void checkMode() {
 void blackoutSetup() {
   Serial.begin(115200);
 
-  esp_bt_controller_deinit();
-  esp_wifi_stop();
-  esp_wifi_deinit();
-  esp_wifi_disconnect();
-
-  pinMode(MODE_BUTTON, INPUT_PULLUP);
-  pinMode(MODE_BUTTON1, INPUT_PULLUP);
-  pinMode(MODE_BUTTON2, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(MODE_BUTTON), handleButton, FALLING);
-  attachInterrupt(digitalPinToInterrupt(MODE_BUTTON1), handleButton1, FALLING);
-  attachInterrupt(digitalPinToInterrupt(MODE_BUTTON2), handleButton2, FALLING);
-
   initialize_Radios();
   update_OLED();
 }
 
+void blackoutStop() {
+  current = DEACTIVE_MODE;
+  initialize_Radios();
+}
+
 void blackoutLoop() {
   checkMode();
 
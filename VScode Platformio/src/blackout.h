@@ -16,5 +16,6 @@
 
 void blackoutSetup();
 void blackoutLoop();
+void blackoutStop();
 
 #endif
@@ -0,0 +1,245 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include "blecount.h"
+#include "hll.h"
+#include "bledevices.h"
+#include "app.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define BUTTON_PIN_UP     26
+#define BUTTON_PIN_DOWN   33
+
+#define SLOT_MS        15000UL   // one sketch set per 15 s
+#define SLOT_COUNT     8         // 2 minutes of history
+#define SLOT_EMPTY     0xFFFFFFFFUL
+#define REDRAW_MS      250
+
+enum CountKind : uint8_t {
+  KIND_TOTAL = 0,
+  KIND_APPLE,
+  KIND_MICROSOFT,
+  KIND_SAMSUNG,
+  KIND_GOOGLE,
+  KIND_OTHER,
+  KIND_PUBLIC,
+  KIND_STATIC,
+  KIND_RPA,
+  KIND_NRPA,
+  KIND_COUNT
+};
+
+struct CountWindow {
+  const char *label;
+  int slots;        // 0 == whole session
+};
+
+static const CountWindow windows[] = {
+  { "1 min", 4 },
+  { "2 min", SLOT_COUNT },
+  { "all",   0 }
+};
+static const int windowCount = sizeof(windows) / sizeof(windows[0]);
+
+// (SLOT_COUNT + 1) * KIND_COUNT * HLL_BYTES = 5760 bytes in total
+static HllSketch slots[SLOT_COUNT][KIND_COUNT];
+static uint32_t slotEpoch[SLOT_COUNT];
+static HllSketch session[KIND_COUNT];
+
+static portMUX_TYPE countMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool counting = false;
+static volatile uint32_t advCount = 0;
+
+static int windowIndex = 0;
+static unsigned long lastDraw = 0;
+static uint32_t lastAdvCount = 0;
+static unsigned long lastRateMs = 0;
+static uint32_t advPerSec = 0;
+
+static esp_ble_scan_params_t countScanParams = {
+  .scan_type          = BLE_SCAN_TYPE_PASSIVE,
+  .own_addr_type      = BLE_ADDR_TYPE_PUBLIC,
+  .scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL,
+  .scan_interval      = 0x50,
+  .scan_window        = 0x50,
+  .scan_duplicate     = BLE_SCAN_DUPLICATE_DISABLE   // repeats are free in a sketch
+};
+
+// Company ID from the first manufacturer-specific AD structure
+static uint8_t vendorKind(const uint8_t *adv, int len) {
+  uint8_t n = 0;
+  const uint8_t *m = bleAdFind(adv, len, ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE, &n);
+  if (!m || n < 2) return KIND_OTHER;
+  switch (m[0] | (m[1] << 8)) {
+    case 0x004C: return KIND_APPLE;
+    case 0x0006: return KIND_MICROSOFT;
+    case 0x0075: return KIND_SAMSUNG;
+    case 0x00E0: return KIND_GOOGLE;
+    default:     return KIND_OTHER;
+  }
+}
+
+// Random addresses carry their sub-type in the two top bits
+static uint8_t addrKind(const uint8_t *bda, esp_ble_addr_type_t type) {
+  if (type == BLE_ADDR_TYPE_PUBLIC) return KIND_PUBLIC;
+  if (type != BLE_ADDR_TYPE_RANDOM) return KIND_RPA;
+  switch (bda[0] >> 6) {
+    case 0x3: return KIND_STATIC;
+    case 0x1: return KIND_RPA;
+    default:  return KIND_NRPA;
+  }
+}
+
+static void countAdvert(const uint8_t *bda, esp_ble_addr_type_t type, const uint8_t *adv, int len) {
+  uint64_t h = hllHashAddr(bda);
+  uint8_t vendor = vendorKind(adv, len);
+  uint8_t kind = addrKind(bda, type);
+  uint32_t epoch = millis() / SLOT_MS;
+  int slot = epoch % SLOT_COUNT;
+
+  portENTER_CRITICAL(&countMux);
+  if (slotEpoch[slot] != epoch) {
+    memset(slots[slot], 0, sizeof(slots[slot]));
+    slotEpoch[slot] = epoch;
+  }
+  hllAdd(slots[slot][KIND_TOTAL], h);
+  hllAdd(slots[slot][vendor], h);
+  hllAdd(slots[slot][kind], h);
+  hllAdd(session[KIND_TOTAL], h);
+  hllAdd(session[vendor], h);
+  hllAdd(session[kind], h);
+  advCount++;
+  portEXIT_CRITICAL(&countMux);
+}
+
+static void countGapHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (!counting) return;
+
+  switch (event) {
+    case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
+      esp_ble_gap_start_scanning(0);
+      break;
+
+    case ESP_GAP_BLE_SCAN_RESULT_EVT:
+      if (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
+        countAdvert(param->scan_rst.bda, param->scan_rst.ble_addr_type, param->scan_rst.ble_adv,
+                    param->scan_rst.adv_data_len + param->scan_rst.scan_rsp_len);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+// Union of the sketches that fall inside the window, for every kind
+static void windowEstimate(int slotsBack, uint32_t out[KIND_COUNT]) {
+  static HllSketch merged[KIND_COUNT];
+  uint32_t nowEpoch = millis() / SLOT_MS;
+
+  if (slotsBack == 0) {
+    portENTER_CRITICAL(&countMux);
+    memcpy(merged, session, sizeof(merged));
+    portEXIT_CRITICAL(&countMux);
+  } else {
+    memset(merged, 0, sizeof(merged));
+    // lock per slot so the BT task is never held off for a whole merge
+    for (int s = 0; s < SLOT_COUNT; s++) {
+      portENTER_CRITICAL(&countMux);
+      if (slotEpoch[s] != SLOT_EMPTY && nowEpoch - slotEpoch[s] < (uint32_t)slotsBack) {
+        for (int k = 0; k < KIND_COUNT; k++) hllMerge(merged[k], slots[s][k]);
+      }
+      portEXIT_CRITICAL(&countMux);
+    }
+  }
+
+  for (int k = 0; k < KIND_COUNT; k++) out[k] = hllEstimate(merged[k]);
+}
+
+static void drawCount(int x, int y, const char *label, uint32_t value) {
+  u8g2.setCursor(x, y);
+  u8g2.print(label);
+  u8g2.print(value);
+}
+
+void blecountSetup() {
+  BLEDevice::init("");
+  BLEDevice::getScan()->stop();
+
+  memset(slots, 0, sizeof(slots));
+  memset(session, 0, sizeof(session));
+  for (int s = 0; s < SLOT_COUNT; s++) slotEpoch[s] = SLOT_EMPTY;
+  advCount = 0;
+  lastAdvCount = 0;
+  advPerSec = 0;
+  lastRateMs = millis();
+  lastDraw = 0;
+
+  counting = true;
+  BLEDevice::setCustomGapHandler(countGapHandler);
+  esp_ble_gap_set_scan_params(&countScanParams);
+}
+
+void blecountStop() {
+  if (!counting) return;
+  counting = false;
+  esp_ble_gap_stop_scanning();
+}
+
+void blecountLoop() {
+  unsigned long now = millis();
+
+  if (appPressedRepeat(BUTTON_PIN_UP)) {
+    windowIndex = (windowIndex + windowCount - 1) % windowCount;
+    lastDraw = 0;
+  }
+  if (appPressedRepeat(BUTTON_PIN_DOWN)) {
+    windowIndex = (windowIndex + 1) % windowCount;
+    lastDraw = 0;
+  }
+
+  if (lastDraw != 0 && now - lastDraw < REDRAW_MS) return;
+  lastDraw = now;
+
+  if (now - lastRateMs >= 1000) {
+    uint32_t total = advCount;
+    advPerSec = (total - lastAdvCount) * 1000 / (now - lastRateMs);
+    lastAdvCount = total;
+    lastRateMs = now;
+  }
+
+  uint32_t est[KIND_COUNT];
+  windowEstimate(windows[windowIndex].slots, est);
+
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_6x10_tr);
+  u8g2.drawStr(0, 10, "BLE Count");
+  u8g2.setCursor(72, 10);
+  u8g2.print("[");
+  u8g2.print(windows[windowIndex].label);
+  u8g2.print("]");
+
+  drawCount(0, 22, "Unique: ~", est[KIND_TOTAL]);
+  u8g2.setFont(u8g2_font_5x8_tr);
+  u8g2.setCursor(90, 22);
+  u8g2.print(advPerSec);
+  u8g2.print("/s");
+
+  drawCount(0, 33, "Apple ", est[KIND_APPLE]);
+  drawCount(44, 33, "MS ", est[KIND_MICROSOFT]);
+  drawCount(80, 33, "Sams ", est[KIND_SAMSUNG]);
+  drawCount(0, 42, "Google ", est[KIND_GOOGLE]);
+  drawCount(54, 42, "Other ", est[KIND_OTHER]);
+
+  u8g2.drawHLine(0, 45, 128);
+  drawCount(0, 54, "Pub ", est[KIND_PUBLIC]);
+  drawCount(44, 54, "Static ", est[KIND_STATIC]);
+  drawCount(0, 63, "RPA ", est[KIND_RPA]);
+  drawCount(44, 63, "NRPA ", est[KIND_NRPA]);
+
+  u8g2.sendBuffer();
+}
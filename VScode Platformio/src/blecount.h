@@ -0,0 +1,17 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef blecount_H
+#define blecount_H
+
+#include <BLEDevice.h>
+#include <U8g2lib.h>
+#include "esp_gap_ble_api.h"
+
+void blecountSetup();
+void blecountLoop();
+void blecountStop();
+
+#endif
@@ -0,0 +1,269 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include "bledevices.h"
+#include "scanlog.h"
+#include "diag.h"
+#include "fmt.h"
+#include "neopixel.h"
+
+// Passive unless the profile says otherwise; scan responses are requested
+// per device from the detail view (bletrack.cpp) instead.
+static const BleScanProfileDef profiles[BLE_PROFILE_COUNT] = {
+  { "Passive fast", 0x50,  0x50, false, true  },   //  50 ms /  50 ms, 100 %
+  { "Balanced",     0xA0,  0x50, false, false },   // 100 ms /  50 ms,  50 %
+  { "Low power",    0x320, 0x50, false, true  },   // 500 ms /  50 ms,  10 %
+  { "Active",       0x50,  0x30, true,  true  }    //  50 ms /  30 ms,  60 %
+};
+
+uint8_t bleScanProfile = BLE_PROFILE_PASSIVE_FAST;
+
+static BleDevice devices[BLE_MAX_DEVICES];
+static volatile int deviceCount = 0;
+static portMUX_TYPE devicesMux = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool scanning = false;
+static volatile bool scanFinished = false;   // set by the BT task, stats still to report
+static BleAddrFilter addrFilter = nullptr;
+static unsigned long scanStartMs = 0;
+static uint8_t scanProfile = BLE_PROFILE_PASSIVE_FAST;
+static uint32_t scanSeconds = 0;
+static BleScanStats lastStats = { BLE_PROFILE_PASSIVE_FAST, 0, 0, 0, 0 };
+
+static esp_ble_scan_params_t scanParams = {
+  .scan_type          = BLE_SCAN_TYPE_PASSIVE,
+  .own_addr_type      = BLE_ADDR_TYPE_PUBLIC,
+  .scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL,
+  .scan_interval      = 0x50,
+  .scan_window        = 0x50,
+  .scan_duplicate     = BLE_SCAN_DUPLICATE_ENABLE
+};
+
+const BleScanProfileDef &bleProfileDef(uint8_t profile) {
+  return profiles[profile < BLE_PROFILE_COUNT ? profile : 0];
+}
+
+uint8_t bleProfileDutyPercent(uint8_t profile) {
+  const BleScanProfileDef &p = bleProfileDef(profile);
+  return (uint8_t)((p.window * 100UL) / p.interval);
+}
+
+const uint8_t *bleAdFind(const uint8_t *adv, int len, uint8_t type, uint8_t *outLen) {
+  int i = 0;
+  while (i + 1 < len) {
+    uint8_t fieldLen = adv[i];
+    if (fieldLen == 0 || i + 1 + fieldLen > len) break;
+    if (adv[i + 1] == type) {
+      *outLen = fieldLen - 1;
+      return &adv[i + 2];
+    }
+    i += fieldLen + 1;
+  }
+  *outLen = 0;
+  return nullptr;
+}
+
+void bleAdName(const uint8_t *adv, int len, char *out, size_t outSize) {
+  uint8_t n = 0;
+  const uint8_t *p = bleAdFind(adv, len, ESP_BLE_AD_TYPE_NAME_CMPL, &n);
+  if (!p) p = bleAdFind(adv, len, ESP_BLE_AD_TYPE_NAME_SHORT, &n);
+  if (!p) return;
+  if (n >= outSize) n = outSize - 1;
+  memcpy(out, p, n);
+  out[n] = '\0';
+}
+
+// UI task only (bledevicesPoll / bledevicesStop), never from the GAP callback
+static void reportStats() {
+  static uint32_t latency[BLE_MAX_DEVICES];
+  portENTER_CRITICAL(&devicesMux);
+  int n = deviceCount;
+  for (int i = 0; i < n; i++) latency[i] = devices[i].firstSeenMs;
+  portEXIT_CRITICAL(&devicesMux);
+
+  uint64_t sum = 0;
+  for (int i = 0; i < n; i++) sum += latency[i];
+  std::sort(latency, latency + n);
+
+  lastStats.profile  = scanProfile;
+  lastStats.devices  = n;
+  lastStats.meanMs   = n ? (uint32_t)(sum / n) : 0;
+  lastStats.medianMs = n ? latency[n / 2] : 0;
+  lastStats.p90Ms    = n ? latency[(n * 9) / 10] : 0;
+
+  const BleScanProfileDef &p = bleProfileDef(scanProfile);
+  Serial.printf("BLE scan [%s] %s, interval %u us, window %u us, duty %u%%\n",
+                p.name, p.active ? "active" : "passive",
+                p.interval * 625U, p.window * 625U, bleProfileDutyPercent(scanProfile));
+  Serial.printf("  %d devices in %u s, discovery latency mean %u ms, median %u ms, p90 %u ms\n",
+                n, (unsigned)scanSeconds, (unsigned)lastStats.meanMs,
+                (unsigned)lastStats.medianMs, (unsigned)lastStats.p90Ms);
+}
+
+static void noteAdvert(esp_ble_gap_cb_param_t *param) {
+  DIAG_SCOPE("ble advert");
+  const uint8_t *bda = param->scan_rst.bda;
+  if (addrFilter && !addrFilter(bda)) return;
+
+  uint8_t *adv = param->scan_rst.ble_adv;
+  int advLen = param->scan_rst.adv_data_len + param->scan_rst.scan_rsp_len;
+  uint32_t now = millis() - scanStartMs;
+
+  bool isNew = false;
+  BleDevice copy;
+  portENTER_CRITICAL(&devicesMux);
+  int found = -1;
+  for (int i = 0; i < deviceCount; i++) {
+    if (memcmp(devices[i].addr, bda, sizeof(esp_bd_addr_t)) == 0) {
+      found = i;
+      break;
+    }
+  }
+  if (found < 0 && deviceCount < BLE_MAX_DEVICES) {
+    found = deviceCount;
+    BleDevice &d = devices[found];
+    memcpy(d.addr, bda, sizeof(esp_bd_addr_t));
+    d.addrType = param->scan_rst.ble_addr_type;
+    d.company = 0xFFFF;
+    d.name[0] = '\0';
+    d.firstSeenMs = now;
+    deviceCount = found + 1;
+    isNew = true;
+  }
+  if (found >= 0) {
+    BleDevice &d = devices[found];
+    d.rssi = param->scan_rst.rssi;
+    d.lastSeenMs = now;
+    if (d.name[0] == '\0') bleAdName(adv, advLen, d.name, sizeof(d.name));
+    if (d.company == 0xFFFF) {
+      uint8_t n = 0;
+      const uint8_t *m = bleAdFind(adv, advLen, ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE, &n);
+      if (m && n >= 2) d.company = m[0] | (m[1] << 8);
+    }
+    if (isNew) copy = d;
+  }
+  portEXIT_CRITICAL(&devicesMux);
+
+  // log outside the lock; the company ID is only known if this first advert had it
+  if (isNew) {
+    scanlogBle(copy.addr, copy.addrType, copy.rssi, copy.company);
+    ledStatus(LED_NEW_DEVICE);
+  }
+}
+
+static void devicesGapHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (!scanning) return;
+
+  switch (event) {
+    case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
+      scanStartMs = millis();
+      esp_ble_gap_start_scanning(scanSeconds);
+      break;
+
+    case ESP_GAP_BLE_SCAN_RESULT_EVT:
+      if (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
+        noteAdvert(param);
+      } else if (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+        // the stats are left to the UI task, the BT stack should not sort or print
+        portENTER_CRITICAL(&devicesMux);
+        if (scanning) scanFinished = true;
+        scanning = false;
+        portEXIT_CRITICAL(&devicesMux);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void bledevicesStart(uint32_t seconds, BleAddrFilter filter) {
+  BLEDevice::getScan()->stop();
+
+  portENTER_CRITICAL(&devicesMux);
+  deviceCount = 0;
+  scanFinished = false;
+  portEXIT_CRITICAL(&devicesMux);
+
+  const BleScanProfileDef &p = bleProfileDef(bleScanProfile);
+  scanParams.scan_type      = p.active ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
+  scanParams.scan_interval  = p.interval;
+  scanParams.scan_window    = p.window;
+  scanParams.scan_duplicate = p.filterDuplicates ? BLE_SCAN_DUPLICATE_ENABLE : BLE_SCAN_DUPLICATE_DISABLE;
+
+  addrFilter = filter;
+  scanProfile = bleScanProfile;
+  scanSeconds = seconds;
+  scanStartMs = millis();
+  scanning = true;
+
+  BLEDevice::setCustomGapHandler(devicesGapHandler);
+  // scanning starts from devicesGapHandler once the parameters are accepted
+  esp_ble_gap_set_scan_params(&scanParams);
+}
+
+void bledevicesStop() {
+  // test-and-clear against the GAP callback finishing the scan at the same time
+  portENTER_CRITICAL(&devicesMux);
+  bool wasScanning = scanning;
+  bool report = wasScanning || scanFinished;
+  scanning = false;
+  scanFinished = false;
+  portEXIT_CRITICAL(&devicesMux);
+
+  if (wasScanning) esp_ble_gap_stop_scanning();
+  if (report) reportStats();
+}
+
+void bledevicesPoll() {
+  portENTER_CRITICAL(&devicesMux);
+  bool report = scanFinished;
+  scanFinished = false;
+  portEXIT_CRITICAL(&devicesMux);
+
+  if (report) reportStats();
+}
+
+bool bledevicesScanning() {
+  return scanning;
+}
+
+int bledevicesCount() {
+  return deviceCount;
+}
+
+bool bledevicesGet(int index, BleDevice &out) {
+  bool ok = false;
+  portENTER_CRITICAL(&devicesMux);
+  if (index >= 0 && index < deviceCount) {
+    out = devices[index];
+    ok = true;
+  }
+  portEXIT_CRITICAL(&devicesMux);
+  return ok;
+}
+
+void bledevicesListRow(int index, char *out, size_t size) {
+  BleDevice device;
+  if (bledevicesGet(index, device)) fmtScanRow(out, size, device.name, device.rssi);
+  else out[0] = '\0';
+}
+
+uint32_t bledevicesListKey(int index, uint8_t sort) {
+  BleDevice device;
+  if (!bledevicesGet(index, device)) return UINT32_MAX;
+  switch (sort) {
+    case LIST_SORT_RSSI: return listRssiKey(device.rssi);
+    case LIST_SORT_NAME: return listNameKey(device.name);
+    case LIST_SORT_SEEN: return UINT32_MAX - device.lastSeenMs;
+    default:             return index;
+  }
+}
+
+const BleScanStats &bledevicesLastStats() {
+  return lastStats;
+}
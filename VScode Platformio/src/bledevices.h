@@ -0,0 +1,78 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef bledevices_H
+#define bledevices_H
+
+#include <BLEDevice.h>
+#include "esp_gap_ble_api.h"
+#include "listview.h"
+
+#define BLE_MAX_DEVICES  128
+#define BLE_NAME_LEN      16
+
+struct BleDevice {
+  esp_bd_addr_t addr;
+  uint8_t  addrType;        // esp_ble_addr_type_t
+  int8_t   rssi;
+  uint16_t company;         // manufacturer data company ID, 0xFFFF if none
+  char     name[BLE_NAME_LEN + 1];
+  uint32_t firstSeenMs;     // since scan start
+  uint32_t lastSeenMs;
+};
+
+// Scan profiles. Interval and window are in 0.625 ms controller units.
+enum BleScanProfile : uint8_t {
+  BLE_PROFILE_PASSIVE_FAST = 0,
+  BLE_PROFILE_BALANCED,
+  BLE_PROFILE_LOW_POWER,
+  BLE_PROFILE_ACTIVE,
+  BLE_PROFILE_COUNT
+};
+
+struct BleScanProfileDef {
+  const char *name;
+  uint16_t interval;
+  uint16_t window;
+  bool     active;
+  bool     filterDuplicates;
+};
+
+struct BleScanStats {
+  uint8_t  profile;
+  int      devices;
+  uint32_t meanMs;          // time from scan start to first sighting
+  uint32_t medianMs;
+  uint32_t p90Ms;
+};
+
+extern uint8_t bleScanProfile;     // persisted by config.h
+
+const BleScanProfileDef &bleProfileDef(uint8_t profile);
+uint8_t bleProfileDutyPercent(uint8_t profile);
+
+// Only addresses the filter accepts are added to the table
+typedef bool (*BleAddrFilter)(const uint8_t *addr);
+
+void bledevicesStart(uint32_t seconds, BleAddrFilter filter);
+void bledevicesStop();
+// Reports the stats of a scan that ran out; the screens call it every frame
+void bledevicesPoll();
+bool bledevicesScanning();
+int  bledevicesCount();
+bool bledevicesGet(int index, BleDevice &out);
+const BleScanStats &bledevicesLastStats();
+
+// List widget source over the device table (listview.h)
+#define BLE_LIST_SORTS ((1 << LIST_SORT_RSSI) | (1 << LIST_SORT_NAME) | (1 << LIST_SORT_SEEN))
+void bledevicesListRow(int index, char *out, size_t size);
+uint32_t bledevicesListKey(int index, uint8_t sort);
+
+// Walks the AD structures of an advertisement; returns the payload of the
+// first field of the given type, or nullptr.
+const uint8_t *bleAdFind(const uint8_t *adv, int len, uint8_t type, uint8_t *outLen);
+void bleAdName(const uint8_t *adv, int len, char *out, size_t outSize);
+
+#endif
@@ -5,6 +5,7 @@
 
 #include <Arduino.h> 
 #include "blejammer.h"
+#include "app.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -34,22 +35,9 @@ byte channelGroup1[] = {2, 5, 8, 11};
 byte channelGroup2[] = {26, 29, 32, 35}; 
 byte channelGroup3[] = {80, 83, 86, 89}; 
 
-volatile bool modeChangeRequested = false;
-
 unsigned long lastJammingTime = 0;
 const unsigned long jammingInterval = 10;
 
-unsigned long lastButtonPressTime = 0;
-const unsigned long debounceDelay = 500;
-
-void IRAM_ATTR handleButtonPress() {
-  unsigned long currentTime = millis();
-  if (currentTime - lastButtonPressTime > debounceDelay) {
-    modeChangeRequested = true;
-    lastButtonPressTime = currentTime;
-  }
-}
-
 void configureRadio(RF24 &radio, const byte* channels, size_t size) {
   radio.setAutoAck(false);
   radio.stopListening();
@@ -84,7 +72,6 @@ void initializeRadios() {
     radio1.powerDown();
     radio2.powerDown();
     radio3.powerDown();
-    delay(100);
   } 
 }
 
@@ -128,8 +115,8 @@ void updateOLED() {
 }
 
 void checkModeChange() {
-  if (modeChangeRequested) {
-    modeChangeRequested = false;
+  // MODE_BUTTON arrives through the app runtime's input queue (input.h)
+  if (appPressed(MODE_BUTTON)) {
     currentMode = static_cast<OperationMode>((currentMode + 1) % 3);
     initializeRadios();
     updateOLED();
@@ -139,18 +126,15 @@ void checkModeChange() {
 void blejammerSetup() {
   Serial.begin(115200);
 
-  esp_bt_controller_deinit();
-  esp_wifi_stop();
-  esp_wifi_deinit();
-  esp_wifi_disconnect();
-
-  pinMode(MODE_BUTTON, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(MODE_BUTTON), handleButtonPress, FALLING);
-
   initializeRadios();
   updateOLED();
 }
 
+void blejammerStop() {
+  currentMode = DEACTIVE_MODE;
+  initializeRadios();
+}
+
 void blejammerLoop() {
   checkModeChange();
 
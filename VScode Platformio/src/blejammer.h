@@ -16,5 +16,6 @@
 
 void blejammerSetup();
 void blejammerLoop();
+void blejammerStop();
 
 #endif
@@ -10,5 +10,7 @@
 #include <U8g2lib.h>
 
 void blescanSetup();
+void blescanLoop();
+void blescanStop();
 
 #endif
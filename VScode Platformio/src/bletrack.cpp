@@ -0,0 +1,253 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include "bletrack.h"
+#include "fmt.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define TRACK_HISTORY      100   // graph columns
+#define TRACK_SAMPLE_MS     50   // one graph column every 50 ms
+#define TRACK_RSSI_MIN    -100
+#define TRACK_RSSI_MAX     -30
+#define TRACK_LOST_MS     2000   // no advert for this long: "lost"
+
+#define GRAPH_X   0
+#define GRAPH_Y  20
+#define GRAPH_H  32
+
+// 30 ms interval == 30 ms window: listen continuously, only our address passes
+static esp_ble_scan_params_t trackScanParams = {
+  .scan_type          = BLE_SCAN_TYPE_ACTIVE,
+  .own_addr_type      = BLE_ADDR_TYPE_PUBLIC,
+  .scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ONLY_WLST,
+  .scan_interval      = 0x30,
+  .scan_window        = 0x30,
+  .scan_duplicate     = BLE_SCAN_DUPLICATE_DISABLE
+};
+
+static portMUX_TYPE trackMux = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool tracking = false;
+static esp_bd_addr_t targetAddr;
+static esp_ble_wl_addr_type_t targetType = BLE_WL_ADDR_TYPE_PUBLIC;
+static char targetLabel[18];
+static char targetAddrStr[FMT_MAC_LEN];
+static int targetRssiAtScan = 0;
+static volatile bool nameFromResponse = false;
+
+// written by the BT task, read by the UI
+static volatile int lastRssi = TRACK_RSSI_MIN;
+static volatile int32_t smoothQ4 = TRACK_RSSI_MIN * 16;   // EMA, 1/16 dBm units
+static volatile uint32_t sampleCount = 0;
+static volatile unsigned long lastSeenMs = 0;
+
+static int8_t history[TRACK_HISTORY];
+static int historyHead = 0;
+static unsigned long lastHistoryMs = 0;
+
+static uint32_t rateBase = 0;
+static unsigned long rateStartMs = 0;
+static int samplesPerSec = 0;
+
+// what the detail page last showed
+static int shownRssi = 0;
+static bool shownLost = false;
+
+static void trackGapHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (!tracking) return;
+
+  switch (event) {
+    case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
+      esp_ble_gap_start_scanning(0);
+      break;
+
+    case ESP_GAP_BLE_SCAN_RESULT_EVT: {
+      if (param->scan_rst.search_evt != ESP_GAP_SEARCH_INQ_RES_EVT) break;
+      // The whitelist already filtered in hardware; compare the address only.
+      // The payload is decoded once, for the name in the first scan response.
+      if (memcmp(param->scan_rst.bda, targetAddr, sizeof(esp_bd_addr_t)) != 0) break;
+
+      int rssi = param->scan_rst.rssi;
+      if (param->scan_rst.ble_evt_type == ESP_BLE_EVT_SCAN_RSP && !nameFromResponse) {
+        char name[sizeof(targetLabel)] = "";
+        bleAdName(param->scan_rst.ble_adv, param->scan_rst.adv_data_len + param->scan_rst.scan_rsp_len,
+                  name, sizeof(name));
+        if (name[0]) {
+          portENTER_CRITICAL(&trackMux);
+          memcpy(targetLabel, name, sizeof(targetLabel));
+          portEXIT_CRITICAL(&trackMux);
+          nameFromResponse = true;
+        }
+      }
+
+      portENTER_CRITICAL(&trackMux);
+      lastRssi = rssi;
+      smoothQ4 += ((rssi * 16) - smoothQ4) / 4;
+      sampleCount++;
+      lastSeenMs = millis();
+      portEXIT_CRITICAL(&trackMux);
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void bletrackStart(const BleDevice &device) {
+  bledevicesStop();
+
+  memcpy(targetAddr, device.addr, sizeof(esp_bd_addr_t));
+  targetType = device.addrType == BLE_ADDR_TYPE_PUBLIC ? BLE_WL_ADDR_TYPE_PUBLIC : BLE_WL_ADDR_TYPE_RANDOM;
+
+  fmtMac(targetAddrStr, sizeof(targetAddrStr), device.addr);
+  strncpy(targetLabel, device.name[0] ? device.name : "No Name", sizeof(targetLabel) - 1);
+  targetLabel[sizeof(targetLabel) - 1] = '\0';
+  nameFromResponse = false;
+
+  int rssi = device.rssi;
+  targetRssiAtScan = rssi;
+  lastRssi = rssi;
+  smoothQ4 = rssi * 16;
+  sampleCount = 0;
+  lastSeenMs = millis();
+  for (int i = 0; i < TRACK_HISTORY; i++) history[i] = rssi;
+  historyHead = 0;
+  lastHistoryMs = millis();
+  rateBase = 0;
+  rateStartMs = millis();
+  samplesPerSec = 0;
+
+  tracking = true;
+  BLEDevice::setCustomGapHandler(trackGapHandler);
+
+  esp_ble_gap_clear_whitelist();
+  esp_ble_gap_update_whitelist(true, targetAddr, targetType);
+  // scanning starts from trackGapHandler once the parameters are accepted
+  esp_ble_gap_set_scan_params(&trackScanParams);
+}
+
+void bletrackStop() {
+  if (!tracking) return;
+  tracking = false;
+  esp_ble_gap_stop_scanning();
+  esp_ble_gap_update_whitelist(false, targetAddr, targetType);
+}
+
+bool bletrackActive() {
+  return tracking;
+}
+
+bool bletrackChanged() {
+  portENTER_CRITICAL(&trackMux);
+  int raw = lastRssi;
+  unsigned long seen = lastSeenMs;
+  portEXIT_CRITICAL(&trackMux);
+
+  bool lost = millis() - seen > TRACK_LOST_MS;
+  bool changed = raw != shownRssi || lost != shownLost;
+  shownRssi = raw;
+  shownLost = lost;
+  return changed;
+}
+
+static int rssiToY(int rssi) {
+  rssi = constrain(rssi, TRACK_RSSI_MIN, TRACK_RSSI_MAX);
+  return GRAPH_Y + GRAPH_H - 1 - ((rssi - TRACK_RSSI_MIN) * (GRAPH_H - 1)) / (TRACK_RSSI_MAX - TRACK_RSSI_MIN);
+}
+
+void bletrackDrawDetails() {
+  char label[sizeof(targetLabel)];
+  portENTER_CRITICAL(&trackMux);
+  int raw = lastRssi;
+  unsigned long seen = lastSeenMs;
+  memcpy(label, targetLabel, sizeof(label));
+  portEXIT_CRITICAL(&trackMux);
+
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_6x10_tr);
+  u8g2.drawStr(0, 10, "Device Details:");
+  u8g2.setFont(u8g2_font_5x8_tr);
+  u8g2.setCursor(0, 20);
+  u8g2.print("Name: ");
+  u8g2.print(label);
+  u8g2.setCursor(0, 30);
+  u8g2.print("Addr: ");
+  u8g2.print(targetAddrStr);
+  u8g2.setCursor(0, 40);
+  u8g2.print("RSSI: ");
+  u8g2.print(raw);
+  u8g2.print(" (scan ");
+  u8g2.print(targetRssiAtScan);
+  u8g2.print(")");
+  if (millis() - seen > TRACK_LOST_MS) u8g2.print(" lost");
+  u8g2.drawStr(0, 50, "LEFT: back  RIGHT: track");
+  u8g2.sendBuffer();
+}
+
+void bletrackDraw() {
+  unsigned long now = millis();
+
+  char label[sizeof(targetLabel)];
+  portENTER_CRITICAL(&trackMux);
+  int raw = lastRssi;
+  int smooth = smoothQ4 / 16;
+  uint32_t count = sampleCount;
+  unsigned long seen = lastSeenMs;
+  memcpy(label, targetLabel, sizeof(label));
+  portEXIT_CRITICAL(&trackMux);
+
+  while (now - lastHistoryMs >= TRACK_SAMPLE_MS) {
+    lastHistoryMs += TRACK_SAMPLE_MS;
+    history[historyHead] = smooth;
+    historyHead = (historyHead + 1) % TRACK_HISTORY;
+  }
+
+  if (now - rateStartMs >= 1000) {
+    samplesPerSec = (count - rateBase) * 1000 / (now - rateStartMs);
+    rateBase = count;
+    rateStartMs = now;
+  }
+
+  bool stale = now - seen > TRACK_LOST_MS;
+
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_5x8_tr);
+  u8g2.drawStr(0, 7, label);
+  u8g2.setCursor(100, 7);
+  u8g2.print(samplesPerSec);
+  u8g2.print("/s");
+
+  u8g2.setCursor(0, 16);
+  u8g2.print("RSSI ");
+  u8g2.print(raw);
+  u8g2.print("  avg ");
+  u8g2.print(smooth);
+  if (stale) u8g2.print("  lost");
+
+  // trend graph, oldest sample on the left
+  u8g2.drawFrame(GRAPH_X, GRAPH_Y - 1, TRACK_HISTORY + 2, GRAPH_H + 2);
+  int prevY = rssiToY(history[historyHead]);
+  for (int i = 1; i < TRACK_HISTORY; i++) {
+    int y = rssiToY(history[(historyHead + i) % TRACK_HISTORY]);
+    u8g2.drawLine(GRAPH_X + i, prevY, GRAPH_X + 1 + i, y);
+    prevY = y;
+  }
+
+  // proximity: vertical bar right of the graph plus a horizontal bar below
+  int level = constrain(smooth, TRACK_RSSI_MIN, TRACK_RSSI_MAX) - TRACK_RSSI_MIN;
+  int span = TRACK_RSSI_MAX - TRACK_RSSI_MIN;
+  int barH = (level * GRAPH_H) / span;
+  u8g2.drawFrame(106, GRAPH_Y - 1, 22, GRAPH_H + 2);
+  u8g2.drawBox(108, GRAPH_Y + GRAPH_H - barH, 18, barH);
+
+  int barW = (level * 124) / span;
+  u8g2.drawFrame(0, 56, 128, 8);
+  if (!stale) u8g2.drawBox(2, 58, barW, 4);
+
+  u8g2.sendBuffer();
+}
@@ -0,0 +1,29 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef bletrack_H
+#define bletrack_H
+
+#include <BLEDevice.h>
+#include <U8g2lib.h>
+#include "esp_gap_ble_api.h"
+#include "bledevices.h"
+
+// Follow a single advertiser: the controller whitelist drops every other
+// address, so the GAP callback only ever sees the selected device. The scan
+// is active, so only this device is sent scan requests.
+void bletrackStart(const BleDevice &device);
+void bletrackStop();
+bool bletrackActive();
+
+// Detail page with live RSSI and the scan-response name.
+void bletrackDrawDetails();
+// True when the detail page is out of date (new RSSI, or device lost/found)
+bool bletrackChanged();
+
+// Draws the tracking page (RSSI trend graph and proximity bar).
+void bletrackDraw();
+
+#endif
@@ -0,0 +1,108 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <RF24.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "boot.h"
+
+#define CE_PIN_A   5
+#define CSN_PIN_A 17
+#define CE_PIN_B  16
+#define CSN_PIN_B  4
+#define CE_PIN_C  15
+#define CSN_PIN_C  2
+
+#define READY_RADIOS  0x01
+#define READY_MENU    0x02
+
+struct BootStage {
+  const char *name;
+  uint32_t us;
+};
+
+static BootStage stages[BOOT_MAX_STAGES];
+static int stageCount = 0;
+static portMUX_TYPE stageMux = portMUX_INITIALIZER_UNLOCKED;
+
+static EventGroupHandle_t ready = nullptr;
+static int finishedCount = 0;
+static uint8_t radiosFound = 0;
+
+static RF24 probeRadios[3] = {
+  RF24(CE_PIN_A, CSN_PIN_A), RF24(CE_PIN_B, CSN_PIN_B), RF24(CE_PIN_C, CSN_PIN_C)
+};
+
+void bootMark(const char *stage) {
+  uint32_t now = micros();
+  portENTER_CRITICAL(&stageMux);
+  if (stageCount < BOOT_MAX_STAGES) {
+    stages[stageCount].name = stage;
+    stages[stageCount].us = now;
+    stageCount++;
+  }
+  portEXIT_CRITICAL(&stageMux);
+}
+
+// Whichever of the probe and setup() finishes last prints the timeline
+static void finished(EventBits_t bit) {
+  xEventGroupSetBits(ready, bit);
+  portENTER_CRITICAL(&stageMux);
+  bool last = ++finishedCount == 2;
+  portEXIT_CRITICAL(&stageMux);
+  if (last) bootDump();
+}
+
+// Checks each module answers on SPI and leaves it powered down; the screens
+// configure the radios themselves when they start
+static void probeTask(void *) {
+  SPI.begin();
+  for (int i = 0; i < 3; i++) {
+    if (probeRadios[i].begin()) {
+      radiosFound |= 1 << i;
+      probeRadios[i].powerDown();
+    }
+  }
+  SPI.end();
+
+  bootMark("radios probed");
+  finished(READY_RADIOS);
+  vTaskDelete(nullptr);
+}
+
+void bootProbeRadios() {
+  ready = xEventGroupCreate();
+  xTaskCreatePinnedToCore(probeTask, "radioprobe", 3072, nullptr, 2, nullptr, 0);
+}
+
+uint8_t bootWaitRadios() {
+  if (ready) xEventGroupWaitBits(ready, READY_RADIOS, pdFALSE, pdTRUE, portMAX_DELAY);
+  return radiosFound;
+}
+
+void bootDone() {
+  bootMark("menu");
+  finished(READY_MENU);
+}
+
+void bootDump() {
+  BootStage copy[BOOT_MAX_STAGES];
+  portENTER_CRITICAL(&stageMux);
+  int count = stageCount;
+  memcpy(copy, stages, sizeof(copy));
+  portEXIT_CRITICAL(&stageMux);
+
+  Serial.println("boot timeline:");
+  uint32_t prev = 0;
+  for (int i = 0; i < count; i++) {
+    Serial.printf("  %9u us  %+9d  %s\n", (unsigned)copy[i].us,
+                  (int)(copy[i].us - prev), copy[i].name);
+    prev = copy[i].us;
+  }
+  Serial.printf("  radios: %c %c %c\n", (radiosFound & 1) ? 'A' : '-',
+                (radiosFound & 2) ? 'B' : '-', (radiosFound & 4) ? 'C' : '-');
+}
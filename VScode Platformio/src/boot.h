@@ -0,0 +1,41 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef boot_H
+#define boot_H
+
+#include <stdint.h>
+
+// Boot timeline and background radio probe.
+//
+// With FAST_BOOT the splash stays up only while setup() runs. The three nRF24
+// modules are probed by a background task in the meantime, and everything
+// else (SPIFFS, radios, BT, WiFi) is started by the first screen that needs
+// it. Set FAST_BOOT to 0 (e.g. -DFAST_BOOT=0 in build_flags) for the old
+// timed splash and logo.
+#ifndef FAST_BOOT
+#define FAST_BOOT 1
+#endif
+
+#define BOOT_MAX_STAGES 12
+
+// Records a named stage with micros() since reset; name must be a literal
+void bootMark(const char *stage);
+
+// Starts the probe task; the menu does not wait for it
+void bootProbeRadios();
+
+// Blocks until the probe has finished and released the SPI bus.
+// Returns the modules that answered: bit 0 = A, 1 = B, 2 = C.
+uint8_t bootWaitRadios();
+
+// setup() is done and the menu is interactive; prints the timeline as soon
+// as the probe has finished too
+void bootDone();
+
+// Prints the timeline on serial
+void bootDump();
+
+#endif
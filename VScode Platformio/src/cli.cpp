@@ -0,0 +1,349 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "cli.h"
+#include "resources.h"
+#include "config.h"
+#include "scanlog.h"
+#include "diag.h"
+#include "boot.h"
+#include "power.h"
+#include "tiles.h"
+#include "journal.h"
+#include "nrfbus.h"
+
+#define CLI_MAX_ARGS 4
+
+enum StreamMode : uint8_t { STREAM_OFF, STREAM_TEXT, STREAM_BIN };
+
+struct StreamRecord {
+  uint8_t  kind;
+  uint8_t  len;
+  uint32_t ms;
+  uint8_t  data[CLI_STREAM_PAYLOAD];
+};
+
+struct CliCommand {
+  const char *name;
+  const char *usage;
+  bool onUiTask;                   // run between frames by cliFrame()
+  void (*run)(int argc, char **argv);
+};
+
+static const App *appTable = nullptr;
+static int appTableCount = 0;
+
+static QueueHandle_t uiLines = nullptr;
+static QueueHandle_t streamQueue = nullptr;
+static volatile uint8_t streamMode = STREAM_OFF;
+static volatile uint32_t streamDropped = 0;
+
+static char line[CLI_LINE_MAX];
+static int lineLen = 0;
+
+static const char *const streamNames[] = { "", "scanner", "analyzer", "wifi", "ble", "sentinel" };
+
+//----------------------------------------------------------------------------
+// Commands
+//----------------------------------------------------------------------------
+
+static void cmdHelp(int, char **);
+
+static void cmdApps(int, char **) {
+  for (int i = 0; i < appTableCount; i++) Serial.printf("%2d %s\n", i, appTable[i].name);
+  Serial.println("ok");
+}
+
+static void cmdOpen(int argc, char **argv) {
+  if (argc < 2) {
+    Serial.println("err usage: open <index|name>");
+    return;
+  }
+
+  // names may contain spaces: "open wifi scan"
+  char name[CLI_LINE_MAX] = "";
+  for (int i = 1; i < argc; i++) {
+    if (i > 1) strlcat(name, " ", sizeof(name));
+    strlcat(name, argv[i], sizeof(name));
+  }
+
+  char *end;
+  long index = strtol(name, &end, 10);
+  if (*end != '\0') {
+    index = -1;
+    for (int i = 0; i < appTableCount; i++) {
+      if (strcasecmp(appTable[i].name, name) == 0) index = i;
+    }
+  }
+  if (index < 0 || index >= appTableCount) {
+    Serial.println("err no such app");
+    return;
+  }
+
+  appStart(appTable[index]);
+  Serial.printf("ok %s\n", appTable[index].name);
+}
+
+static void cmdExit(int, char **) {
+  appExit();
+  Serial.println("ok");
+}
+
+// Settings go through the config store, which range checks and persists them
+static void cmdSet(int argc, char **argv) {
+  char *end = nullptr;
+  long value = argc == 3 ? strtol(argv[2], &end, 10) : 0;
+  if (argc != 3 || *end != '\0' || !configSet(argv[1], value)) {
+    Serial.println("err usage: set <key> <value>, see get");
+    return;
+  }
+  Serial.println("ok");
+}
+
+static void cmdGet(int, char **) {
+  configPrint();
+  configDump();
+  Serial.printf("app %s\n", appCurrent().name);
+  Serial.println("ok");
+}
+
+static void cmdStream(int argc, char **argv) {
+  if (argc == 2 && strcmp(argv[1], "text") == 0) {
+    streamMode = STREAM_TEXT;
+  } else if (argc == 2 && strcmp(argv[1], "bin") == 0) {
+    streamMode = STREAM_BIN;
+  } else if (argc == 2 && strcmp(argv[1], "off") == 0) {
+    streamMode = STREAM_OFF;
+  } else {
+    Serial.printf("err usage: stream text|bin|off (%u dropped)\n", (unsigned)streamDropped);
+    return;
+  }
+  Serial.println("ok");
+}
+
+static void cmdLog(int argc, char **argv) {
+  char cmd[CLI_LINE_MAX];
+  snprintf(cmd, sizeof(cmd), "log %s", argc > 1 ? argv[1] : "");
+  // the log task prints the reply
+  if (!scanlogCommand(cmd)) Serial.println("err log busy");
+}
+
+static void cmdDiag(int argc, char **argv) {
+  char cmd[CLI_LINE_MAX];
+  snprintf(cmd, sizeof(cmd), argc > 1 ? "diag %s" : "diag", argc > 1 ? argv[1] : "");
+  diagCommand(cmd);
+  Serial.println("ok");
+}
+
+static void cmdBoot(int, char **) {
+  bootDump();
+  Serial.println("ok");
+}
+
+static void cmdRes(int, char **) {
+  resDump();
+  Serial.println("ok");
+}
+
+static void cmdPower(int argc, char **argv) {
+  if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+    powerReset();
+  } else if (argc != 1) {
+    Serial.println("err usage: power [reset]");
+    return;
+  } else {
+    powerDump();
+  }
+  Serial.println("ok");
+}
+
+static void cmdTiles(int, char **) {
+  tileDump();
+  Serial.println("ok");
+}
+
+static void cmdBus(int, char **) {
+  nrfBusDump();
+  Serial.println("ok");
+}
+
+static void cmdJournal(int argc, char **argv) {
+  if (argc == 2 && strcmp(argv[1], "clear") == 0) {
+    journalClear();
+  } else if (argc != 1) {
+    Serial.println("err usage: journal [clear]");
+    return;
+  } else {
+    journalDump();
+  }
+  Serial.println("ok");
+}
+
+static const CliCommand commands[] = {
+  { "help",   "",                       false, cmdHelp },
+  { "apps",   "",                       false, cmdApps },
+  { "open",   "<index|name>",           true,  cmdOpen },
+  { "exit",   "",                       true,  cmdExit },
+  { "set",    "<key> <value>",          true,  cmdSet },
+  { "get",    "",                       true,  cmdGet },
+  { "stream", "text|bin|off",           false, cmdStream },
+  { "log",    "dump|clear|stat",        false, cmdLog },
+  { "diag",   "[on|off|reset]",         false, cmdDiag },
+  { "boot",   "",                       false, cmdBoot },
+  { "res",    "",                       false, cmdRes },
+  { "power",  "[reset]",                false, cmdPower },
+  { "tiles",  "",                       false, cmdTiles },
+  { "journal", "[clear]",               false, cmdJournal },
+  { "bus",    "",                       false, cmdBus },
+};
+static const int commandCount = sizeof(commands) / sizeof(commands[0]);
+
+static void cmdHelp(int, char **) {
+  for (int i = 0; i < commandCount; i++) Serial.printf("%s %s\n", commands[i].name, commands[i].usage);
+  Serial.println("ok");
+}
+
+static const CliCommand *findCommand(const char *name) {
+  for (int i = 0; i < commandCount; i++) {
+    if (strcmp(commands[i].name, name) == 0) return &commands[i];
+  }
+  return nullptr;
+}
+
+// Splits in place; returns the command, or nullptr (after replying) if there is none
+static const CliCommand *parse(char *text, int &argc, char **argv) {
+  argc = 0;
+  char *save;
+  char *tok = strtok_r(text, " \t", &save);
+  for (; tok && argc < CLI_MAX_ARGS; tok = strtok_r(nullptr, " \t", &save)) {
+    argv[argc++] = tok;
+  }
+  if (argc == 0) return nullptr;
+  if (tok) {
+    Serial.println("err too many arguments");
+    return nullptr;
+  }
+
+  const CliCommand *cmd = findCommand(argv[0]);
+  if (!cmd) Serial.println("err unknown command, try help");
+  return cmd;
+}
+
+static void dispatch(const char *text) {
+  char copy[CLI_LINE_MAX];
+  strlcpy(copy, text, sizeof(copy));
+  int argc;
+  char *argv[CLI_MAX_ARGS];
+  const CliCommand *cmd = parse(copy, argc, argv);
+  if (!cmd) return;
+
+  if (!cmd->onUiTask) {
+    cmd->run(argc, argv);
+  } else if (xQueueSend(uiLines, text, 0) != pdTRUE) {
+    Serial.println("err busy");
+  }
+}
+
+void cliFrame() {
+  char text[CLI_LINE_MAX];
+  if (!uiLines || xQueueReceive(uiLines, text, 0) != pdTRUE) return;
+  int argc;
+  char *argv[CLI_MAX_ARGS];
+  const CliCommand *cmd = parse(text, argc, argv);
+  if (cmd) cmd->run(argc, argv);
+}
+
+//----------------------------------------------------------------------------
+// Streaming
+//----------------------------------------------------------------------------
+
+bool cliStreaming() {
+  return streamMode != STREAM_OFF;
+}
+
+void cliStream(uint8_t kind, const void *data, int len) {
+  if (streamMode == STREAM_OFF || !streamQueue) return;
+  StreamRecord rec;
+  rec.kind = kind;
+  rec.len = len > CLI_STREAM_PAYLOAD ? CLI_STREAM_PAYLOAD : len;
+  rec.ms = millis();
+  memcpy(rec.data, data, rec.len);
+  if (xQueueSend(streamQueue, &rec, 0) != pdTRUE) streamDropped++;
+}
+
+static void writeText(const StreamRecord &rec) {
+  const int kinds = sizeof(streamNames) / sizeof(streamNames[0]);
+  Serial.printf("%s %u", rec.kind < kinds ? streamNames[rec.kind] : "?", (unsigned)rec.ms);
+
+  if (rec.kind == CLI_STREAM_SENTINEL) {
+    ScanLogRecord r;
+    memcpy(&r, rec.data, sizeof(r));
+    Serial.printf(" ch%u bands %u hits +%u", r.channel, r.flags, r.vendor);
+  } else if (rec.kind == CLI_STREAM_WIFI || rec.kind == CLI_STREAM_BLE) {
+    ScanLogRecord r;
+    memcpy(&r, rec.data, sizeof(r));
+    Serial.printf(" %02x:%02x:%02x:%02x:%02x:%02x %d %u %u", r.addr[0], r.addr[1], r.addr[2],
+                  r.addr[3], r.addr[4], r.addr[5], r.rssi, r.channel,
+                  rec.kind == CLI_STREAM_WIFI ? r.flags : r.vendor);
+  } else {
+    for (int i = 0; i < rec.len; i++) Serial.printf(" %u", rec.data[i]);
+  }
+  Serial.println();
+}
+
+// One Serial.write() per frame: the UART driver takes its lock per call, so
+// a text line printed by another task can only land between frames
+static void writeBinary(const StreamRecord &rec) {
+  uint8_t frame[7 + CLI_STREAM_PAYLOAD + 1] = { 0xA5, rec.kind, rec.len,
+      (uint8_t)rec.ms, (uint8_t)(rec.ms >> 8), (uint8_t)(rec.ms >> 16), (uint8_t)(rec.ms >> 24) };
+  memcpy(frame + 7, rec.data, rec.len);
+  int end = 7 + rec.len;
+  uint8_t x = 0;
+  for (int i = 1; i < end; i++) x ^= frame[i];
+  frame[end] = x;
+  Serial.write(frame, end + 1);
+}
+
+//----------------------------------------------------------------------------
+// Console task
+//----------------------------------------------------------------------------
+
+static void pollSerial() {
+  while (Serial.available()) {
+    char c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      line[lineLen] = '\0';
+      if (lineLen > 0) dispatch(line);
+      lineLen = 0;
+    } else if (lineLen < CLI_LINE_MAX - 1) {
+      line[lineLen++] = c;
+    }
+  }
+}
+
+static void cliTask(void *) {
+  StreamRecord rec;
+  for (;;) {
+    pollSerial();
+    // waiting on the stream doubles as the serial poll interval
+    if (xQueueReceive(streamQueue, &rec, pdMS_TO_TICKS(10)) == pdTRUE) {
+      if (streamMode == STREAM_BIN) writeBinary(rec);
+      else if (streamMode == STREAM_TEXT) writeText(rec);
+    }
+  }
+}
+
+void cliSetup(const App *apps, int count) {
+  appTable = apps;
+  appTableCount = count;
+  uiLines = xQueueCreate(CLI_UI_QUEUE, CLI_LINE_MAX);
+  streamQueue = xQueueCreate(CLI_STREAM_DEPTH, sizeof(StreamRecord));
+  // low priority on core 0, next to the log writer
+  xTaskCreatePinnedToCore(cliTask, "cli", 4096, nullptr, 1, nullptr, 0);
+}
@@ -0,0 +1,53 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef cli_H
+#define cli_H
+
+#include <stdint.h>
+#include "app.h"
+
+// Line-oriented serial console for scripted surveys (115200 baud, "help"
+// lists the commands). Every command answers with "ok" or "err <reason>"
+// as its last line.
+//
+// The console runs in its own task on core 0. Commands that touch screen
+// state (open, exit, set) are handed to the UI task and run between two
+// frames, so they never interrupt a sweep half way. Stream records are
+// queued by the screens without blocking and written out by the console
+// task; when the host reads too slowly they are dropped and counted.
+//
+// Binary stream frame ("stream bin"):
+//   0xA5 kind len time_ms(u32 LE) payload[len] xor
+// where xor covers kind through the last payload byte. Payloads:
+//   scanner   64 x u8, RPD hit percentage per 2-channel step
+//   analyzer 128 x u8, carrier hits per channel
+//   wifi/ble/sentinel  16-byte ScanLogRecord (scanlog.h)
+// Command replies stay text lines in between frames; a reader resyncs on
+// 0xA5 and checks the xor.
+
+#define CLI_LINE_MAX        64
+#define CLI_UI_QUEUE        4
+#define CLI_STREAM_DEPTH    8
+#define CLI_STREAM_PAYLOAD  128
+
+enum CliStreamKind : uint8_t {
+  CLI_STREAM_SCANNER  = 1,
+  CLI_STREAM_ANALYZER = 2,
+  CLI_STREAM_WIFI     = 3,
+  CLI_STREAM_BLE      = 4,
+  CLI_STREAM_SENTINEL = 5
+};
+
+void cliSetup(const App *apps, int count);
+
+// Called by the app runtime at the start of every frame
+void cliFrame();
+
+bool cliStreaming();
+// Never blocks; payloads longer than CLI_STREAM_PAYLOAD are cut
+void cliStream(uint8_t kind, const void *data, int len);
+
+#endif
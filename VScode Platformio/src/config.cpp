@@ -0,0 +1,250 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "esp_rom_crc.h"
+#include "config.h"
+#include "setting.h"
+#include "bledevices.h"
+#include "scanner.h"
+#include "analyzer.h"
+#include "power.h"
+#include "sentinel.h"
+#include "rpdlevel.h"
+
+#define LEGACY_NEOPIXEL    0
+#define LEGACY_BRIGHTNESS  1
+#define LEGACY_GRAPH       2
+#define LEGACY_BLE_PROFILE 130
+
+struct ConfigField {
+  const char *key;
+  void *value;
+  uint8_t size;            // 1 or 2 bytes
+  uint16_t min;
+  uint16_t max;
+  uint16_t def;
+  void (*apply)();         // pushes a console change to the hardware, may be nullptr
+};
+
+#define FIELD(key, var, min, max, def, apply) { key, &var, sizeof(var), min, max, def, apply }
+
+// A field no longer used keeps its bytes in the image, without a key, so the
+// fields after it stay where older images have them
+static uint16_t retired;
+#define RETIRED(bytes) { nullptr, &retired, bytes, 0, 0xFFFF, 0, nullptr }
+
+// Append only: images store the fields in this order. A change of meaning
+// needs a new CONFIG_VERSION and a migration in configSetup(); a field
+// dropped becomes RETIRED().
+static const ConfigField fields[] = {
+  FIELD("neopixel",        neoPixelActive,    0,  1,                     0,                        nullptr),
+  FIELD("brightness",      oledBrightness,    25, 255,                   128,                      settingApplyBrightness),
+  FIELD("ble.profile",     bleScanProfile,    0,  BLE_PROFILE_COUNT - 1, BLE_PROFILE_PASSIVE_FAST, nullptr),
+  FIELD("scanner.samples", scannerSamples,    1,  255,                   50,                       nullptr),
+  FIELD("analyzer.passes", analyzerPasses,    1,  255,                   50,                       nullptr),
+  FIELD("power.dim",       powerDimSec,       0,  3600,                  30,                       nullptr),
+  FIELD("power.off",       powerOffSec,       0,  3600,                  60,                       nullptr),
+  FIELD("sentinel.period", sentinelPeriodSec, 1,  3600,                  10,                       nullptr),
+  FIELD("sentinel.margin", sentinelMargin,    1,  255,                   4,                        nullptr),
+  FIELD("analyzer.levels", analyzerLevels,    0,  1,                     0,                        nullptr),
+  RETIRED(2),               // rpd.cal1, a 2 Mbps step without the LNA bit, which had no effect
+  FIELD("rpd.1m",          rpdOffset[1],      0,  300,                   30,                       nullptr),
+  FIELD("rpd.250k",        rpdOffset[2],      0,  300,                   90,                       nullptr),
+  FIELD("rpd.spread",      rpdSpread,         10, 200,                   40,                       nullptr),
+  FIELD("analyzer.center", analyzerCenter,    0,  127,                   64,                       nullptr),
+  FIELD("analyzer.span",   analyzerSpan,      1,  128,                   128,                      nullptr),
+};
+
+static const int fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+struct __attribute__((packed)) ConfigHeader {
+  uint16_t magic;
+  uint8_t  version;
+  uint8_t  fieldBytes;
+};
+
+static uint8_t graph[CONFIG_GRAPH_BYTES];
+
+static bool pending = false;
+static uint32_t commitAtMs = 0;
+static uint32_t commits = 0;
+static uint32_t lastCommitUs = 0;
+static const char *origin = "defaults";
+
+static int fieldBytes() {
+  int n = 0;
+  for (int i = 0; i < fieldCount; i++) n += fields[i].size;
+  return n;
+}
+
+static uint16_t getField(const ConfigField &f) {
+  return f.size == 1 ? *(uint8_t *)f.value : *(uint16_t *)f.value;
+}
+
+static void setField(const ConfigField &f, uint16_t v) {
+  if (v < f.min || v > f.max) v = f.def;
+  if (f.size == 1) {
+    *(uint8_t *)f.value = v;
+  } else {
+    *(uint16_t *)f.value = v;
+  }
+}
+
+static const ConfigField *findField(const char *key) {
+  for (int i = 0; i < fieldCount; i++) {
+    if (fields[i].key && strcmp(key, fields[i].key) == 0) return &fields[i];
+  }
+  return nullptr;
+}
+
+static void loadDefaults() {
+  for (int i = 0; i < fieldCount; i++) setField(fields[i], fields[i].def);
+  memset(graph, 0, sizeof(graph));
+}
+
+static bool loadImage() {
+  const int base = CONFIG_OFFSET;
+  ConfigHeader h;
+  EEPROM.readBytes(base, &h, sizeof(h));
+  int bytes = sizeof(h) + CONFIG_GRAPH_BYTES + h.fieldBytes;
+  if (h.magic != CONFIG_MAGIC || h.version != CONFIG_VERSION || base + bytes + 4 > CONFIG_EEPROM_SIZE) {
+    return false;
+  }
+
+  uint32_t crc;
+  EEPROM.readBytes(base + bytes, &crc, sizeof(crc));
+  if (crc != esp_rom_crc32_le(0, EEPROM.getDataPtr() + base, bytes)) return false;
+
+  EEPROM.readBytes(base + sizeof(h), graph, CONFIG_GRAPH_BYTES);
+  int at = base + sizeof(h) + CONFIG_GRAPH_BYTES;
+  int end = at + h.fieldBytes;
+  for (int i = 0; i < fieldCount; i++) {
+    const ConfigField &f = fields[i];
+    uint16_t v = f.def;     // added by newer firmware than the image
+    if (at + f.size <= end) {
+      v = EEPROM.read(at);
+      if (f.size == 2) v |= EEPROM.read(at + 1) << 8;
+    }
+    at += f.size;
+    setField(f, v);
+  }
+
+  // rewrite images from older firmware in the current layout
+  if (h.fieldBytes != fieldBytes()) configGraphChanged();
+  return true;
+}
+
+// Version 1: single bytes at fixed offsets, no checksum. A never-written
+// EEPROM reads all 0x00 (or 0xFF on flash), which used to boot with the
+// display at contrast 0 or 255.
+static bool loadLegacy() {
+  const uint8_t *p = EEPROM.getDataPtr();
+  bool blank00 = true, blankFF = true;
+  for (int i = 0; i <= LEGACY_BLE_PROFILE; i++) {
+    blank00 &= p[i] == 0x00;
+    blankFF &= p[i] == 0xFF;
+  }
+  if (blank00 || blankFF) return false;
+
+  loadDefaults();
+  setField(*findField("neopixel"), p[LEGACY_NEOPIXEL]);
+  setField(*findField("brightness"), p[LEGACY_BRIGHTNESS]);
+  setField(*findField("ble.profile"), p[LEGACY_BLE_PROFILE]);
+  memcpy(graph, p + LEGACY_GRAPH, CONFIG_GRAPH_BYTES);
+  return true;
+}
+
+void configSetup() {
+  EEPROM.begin(CONFIG_EEPROM_SIZE);
+
+  if (loadImage()) {
+    origin = "loaded";
+    return;
+  }
+  if (loadLegacy()) {
+    origin = "migrated from v1";
+  } else {
+    loadDefaults();
+    origin = "defaults";
+  }
+  // store the result right away so the next boot takes the fast path
+  pending = true;
+  commitAtMs = millis();
+}
+
+static void writeImage() {
+  uint8_t image[CONFIG_EEPROM_SIZE - CONFIG_OFFSET];
+  ConfigHeader h = { CONFIG_MAGIC, CONFIG_VERSION, (uint8_t)fieldBytes() };
+
+  int at = 0;
+  memcpy(image, &h, sizeof(h));
+  at += sizeof(h);
+  memcpy(image + at, graph, CONFIG_GRAPH_BYTES);
+  at += CONFIG_GRAPH_BYTES;
+  for (int i = 0; i < fieldCount; i++) {
+    uint16_t v = getField(fields[i]);
+    image[at++] = v;
+    if (fields[i].size == 2) image[at++] = v >> 8;
+  }
+  uint32_t crc = esp_rom_crc32_le(0, image, at);
+  memcpy(image + at, &crc, sizeof(crc));
+  at += sizeof(crc);
+
+  EEPROM.writeBytes(CONFIG_OFFSET, image, at);
+  EEPROM.commit();
+}
+
+void configCommit() {
+  if (!pending) return;
+  uint32_t start = micros();
+  writeImage();
+  lastCommitUs = micros() - start;
+  commits++;
+  pending = false;
+}
+
+void configFrame() {
+  if (pending && (int32_t)(millis() - commitAtMs) >= 0) configCommit();
+}
+
+void configChanged() {
+  // every change pushes the commit out, so a burst ends in one write
+  pending = true;
+  commitAtMs = millis() + CONFIG_COMMIT_MS;
+}
+
+void configGraphChanged() {
+  uint32_t at = millis() + CONFIG_BULK_COMMIT_MS;
+  if (!pending || (int32_t)(at - commitAtMs) < 0) commitAtMs = at;
+  pending = true;
+}
+
+uint8_t *configGraph() {
+  return graph;
+}
+
+bool configSet(const char *key, long value) {
+  const ConfigField *f = findField(key);
+  if (!f || value < f->min || value > f->max) return false;
+  setField(*f, value);
+  if (f->apply) f->apply();
+  configChanged();
+  return true;
+}
+
+void configPrint() {
+  for (int i = 0; i < fieldCount; i++) {
+    const ConfigField &f = fields[i];
+    if (!f.key) continue;
+    Serial.printf("%s %u (%u..%u)\n", f.key, getField(f), f.min, f.max);
+  }
+}
+
+void configDump() {
+  Serial.printf("config v%u %s, %d fields, %u commits, last %u us%s\n", CONFIG_VERSION, origin,
+                fieldCount, (unsigned)commits, (unsigned)lastCommitUs, pending ? ", commit pending" : "");
+}
@@ -0,0 +1,57 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef config_H
+#define config_H
+
+#include <stdint.h>
+
+// Persistent settings.
+//
+// Every setting is a typed field in the table in config.cpp. Each field points
+// at the variable its module already uses and has a range and a default.
+// The store keeps the EEPROM open and the image in RAM. Changing a setting
+// only schedules a commit, and the runtime writes flash once the settings
+// have been quiet for CONFIG_COMMIT_MS. A held button therefore costs one
+// flash write, not one per step.
+//
+// Image at CONFIG_OFFSET:
+//   magic(u16) version(u8) fieldBytes(u8) graph[128] fields... crc32
+// Fields are stored in table order, little endian. A field that is missing
+// (an image from older firmware) or out of range gets its default. Version 1
+// is the raw-offset layout of older firmware (0 NeoPixel, 1 brightness,
+// 2-129 scanner graph, 130 BLE profile). It is migrated on first boot.
+
+#define CONFIG_EEPROM_SIZE    512
+#define CONFIG_OFFSET         256       // above the legacy layout
+#define CONFIG_MAGIC          0x4643    // "CF"
+#define CONFIG_VERSION        2
+#define CONFIG_GRAPH_BYTES    128
+#define CONFIG_COMMIT_MS      2000      // after the last settings change
+#define CONFIG_BULK_COMMIT_MS 60000     // graph data: at most once a minute
+
+// Loads the image, or migrates or defaults it, into the module variables.
+// Does not apply anything to the hardware.
+void configSetup();
+
+// Commits when due; called by the app runtime every frame
+void configFrame();
+
+// A field variable was changed by its module
+void configChanged();
+
+// Console access by key: range checked, applied and scheduled for commit
+bool configSet(const char *key, long value);
+void configPrint();
+
+// Scanner graph kept with the settings
+uint8_t *configGraph();
+void configGraphChanged();
+
+// Writes now if anything is pending
+void configCommit();
+void configDump();
+
+#endif
@@ -0,0 +1,296 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "diag.h"
+#include "app.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define BUTTON_PIN_UP    26
+#define BUTTON_PIN_DOWN  33
+#define BUTTON_PIN_RIGHT 27
+
+#define HEAP_SAMPLE_FRAMES 8      // heap is sampled every this many frames
+
+struct ScreenStats {
+  const char *name;
+  uint32_t hist[DIAG_HIST_BUCKETS];
+  uint32_t frames;                // since the last halving
+  uint32_t maxUs;
+  uint32_t minFreeHeap;
+};
+
+// Tasks whose stack high-water mark is reported. Looked up by name on every
+// read, as the BT tasks come and go with the controller.
+static const char *const watchedTasks[] = {
+  "loopTask", "scanlog", "Tmr Svc", "BTC_TASK", "btController", "wifi"
+};
+static const int watchedCount = sizeof(watchedTasks) / sizeof(watchedTasks[0]);
+
+volatile bool diagOn = false;
+
+static TaskHandle_t allocTask = nullptr;
+static volatile uint32_t allocCount = 0;
+
+#if ALLOC_PROBE
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static inline void countAlloc() {
+  if (allocTask && xTaskGetCurrentTaskHandle() == allocTask) allocCount++;
+}
+
+void *__wrap_malloc(size_t size) {
+  countAlloc();
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  countAlloc();
+  return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  countAlloc();
+  return __real_realloc(ptr, size);
+}
+}
+#endif
+
+void diagAllocWatch() {
+  allocTask = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t diagAllocs() {
+  return allocCount;
+}
+
+static portMUX_TYPE probeMux = portMUX_INITIALIZER_UNLOCKED;
+static DiagProbe *probes = nullptr;
+
+static ScreenStats screens[DIAG_MAX_SCREENS];
+static int screenCount = 0;
+static volatile bool screensReset = false;   // cleared by the UI task itself
+static uint32_t heapSampleFrame = 0;
+
+static int page = 0;
+
+void diagProbeAdd(DiagProbe &probe, uint32_t cycles) {
+  portENTER_CRITICAL(&probeMux);
+  if (!probe.listed) {
+    probe.listed = true;
+    probe.next = probes;
+    probes = &probe;
+  }
+  probe.count++;
+  probe.totalCycles += cycles;
+  if (cycles > probe.maxCycles) probe.maxCycles = cycles;
+  portEXIT_CRITICAL(&probeMux);
+}
+
+void diagSetEnabled(bool on) {
+  diagOn = on;
+}
+
+void diagReset() {
+  portENTER_CRITICAL(&probeMux);
+  for (DiagProbe *p = probes; p; p = p->next) {
+    p->count = 0;
+    p->totalCycles = 0;
+    p->maxCycles = 0;
+  }
+  portEXIT_CRITICAL(&probeMux);
+  screensReset = true;
+}
+
+static ScreenStats *screenFor(const char *name) {
+  for (int i = 0; i < screenCount; i++) {
+    if (screens[i].name == name) return &screens[i];
+  }
+  if (screenCount == DIAG_MAX_SCREENS) return nullptr;
+  ScreenStats &s = screens[screenCount++];
+  memset(&s, 0, sizeof(s));
+  s.name = name;
+  s.minFreeHeap = UINT32_MAX;
+  return &s;
+}
+
+void diagFrame(const char *screen, uint32_t us) {
+  if (!diagOn) return;
+  if (screensReset) {
+    screensReset = false;
+    screenCount = 0;
+  }
+  ScreenStats *s = screenFor(screen);
+  if (!s) return;
+
+  int b = 0;
+  while (b < DIAG_HIST_BUCKETS - 1 && us >= (1000UL << b)) b++;
+  s->hist[b]++;
+  if (us > s->maxUs) s->maxUs = us;
+
+  // rolling: old frames fade out by halving
+  if (++s->frames >= DIAG_HIST_AGE) {
+    s->frames = 0;
+    for (int i = 0; i < DIAG_HIST_BUCKETS; i++) {
+      s->hist[i] /= 2;
+      s->frames += s->hist[i];
+    }
+  }
+
+  if (++heapSampleFrame % HEAP_SAMPLE_FRAMES == 0) {
+    uint32_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    if (freeHeap < s->minFreeHeap) s->minFreeHeap = freeHeap;
+  }
+}
+
+static int stackWatermark(const char *task) {
+  TaskHandle_t handle = xTaskGetHandle(task);
+  return handle ? (int)uxTaskGetStackHighWaterMark(handle) : -1;
+}
+
+static uint32_t cyclesToUs(uint64_t cycles) {
+  return (uint32_t)(cycles / ESP.getCpuFreqMHz());
+}
+
+void diagDump() {
+  Serial.printf("diag %s, heap free %u, min %u, largest %u\n", diagOn ? "on" : "off",
+                (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+                (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+                (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+
+  for (int i = 0; i < watchedCount; i++) {
+    int free = stackWatermark(watchedTasks[i]);
+    if (free >= 0) Serial.printf("stack %-12s %5d bytes never used\n", watchedTasks[i], free);
+  }
+
+  for (int i = 0; i < screenCount; i++) {
+    const ScreenStats &s = screens[i];
+    Serial.printf("loop  %-12s max %6u us, min heap %6u, ms <1..>=64:", s.name, (unsigned)s.maxUs,
+                  s.minFreeHeap == UINT32_MAX ? 0 : (unsigned)s.minFreeHeap);
+    for (int b = 0; b < DIAG_HIST_BUCKETS; b++) Serial.printf(" %u", (unsigned)s.hist[b]);
+    Serial.println();
+  }
+
+  portENTER_CRITICAL(&probeMux);
+  DiagProbe *first = probes;
+  portEXIT_CRITICAL(&probeMux);
+  for (DiagProbe *p = first; p; p = p->next) {
+    // figures are read without the lock; a probe may move on while printing
+    uint32_t count = p->count;
+    Serial.printf("probe %-16s %8u calls, avg %6u us, max %6u us\n", p->name, (unsigned)count,
+                  count ? (unsigned)cyclesToUs(p->totalCycles / count) : 0,
+                  (unsigned)cyclesToUs(p->maxCycles));
+  }
+}
+
+bool diagCommand(const char *cmd) {
+  if (strncmp(cmd, "diag", 4) != 0 || (cmd[4] != '\0' && cmd[4] != ' ')) return false;
+  const char *arg = cmd[4] ? cmd + 5 : "";
+
+  if (strcmp(arg, "on") == 0) {
+    diagSetEnabled(true);
+    Serial.println("diag on");
+  } else if (strcmp(arg, "off") == 0) {
+    diagSetEnabled(false);
+    Serial.println("diag off");
+  } else if (strcmp(arg, "reset") == 0) {
+    diagReset();
+    Serial.println("diag reset");
+  } else {
+    diagDump();
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Diagnostics page: UP/DOWN pick the page, RIGHT switches recording on/off.
+// Page 0 is heap and stacks, page 1 the probes, then one page per screen.
+//----------------------------------------------------------------------------
+
+void diagPageSetup() {
+  page = 0;
+}
+
+static void drawHeapPage(char *line, size_t size) {
+  snprintf(line, size, "free %u", (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+  u8g2.drawStr(0, 18, line);
+  snprintf(line, size, "min  %u", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+  u8g2.drawStr(0, 26, line);
+  snprintf(line, size, "big  %u", (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  u8g2.drawStr(0, 34, line);
+
+  int y = 44;
+  for (int i = 0; i < watchedCount && y <= 64; i++) {
+    int free = stackWatermark(watchedTasks[i]);
+    if (free < 0) continue;
+    snprintf(line, size, "%-12s %5d", watchedTasks[i], free);
+    u8g2.drawStr(0, y, line);
+    y += 8;
+  }
+}
+
+static void drawProbePage(char *line, size_t size) {
+  int y = 18;
+  for (DiagProbe *p = probes; p && y <= 64; p = p->next) {
+    uint32_t count = p->count;
+    snprintf(line, size, "%-13.13s%5u %5u", p->name,
+             count ? (unsigned)cyclesToUs(p->totalCycles / count) : 0,
+             (unsigned)cyclesToUs(p->maxCycles));
+    u8g2.drawStr(0, y, line);
+    y += 8;
+  }
+  if (!probes) u8g2.drawStr(0, 18, "no probes hit yet");
+}
+
+static void drawScreenPage(const ScreenStats &s, char *line, size_t size) {
+  static const char *const labels[DIAG_HIST_BUCKETS] = { "1", "2", "4", "8", "16", "32", "64", "+" };
+
+  snprintf(line, size, "%.12s max %ums", s.name, (unsigned)(s.maxUs / 1000));
+  u8g2.drawStr(0, 18, line);
+
+  uint32_t peak = 1;
+  for (int b = 0; b < DIAG_HIST_BUCKETS; b++) {
+    if (s.hist[b] > peak) peak = s.hist[b];
+  }
+  for (int b = 0; b < DIAG_HIST_BUCKETS; b++) {
+    int h = s.hist[b] ? 1 + (int)(s.hist[b] * 30 / peak) : 0;
+    int x = b * 16;
+    u8g2.drawBox(x + 2, 56 - h, 11, h);
+    u8g2.drawStr(x + 2, 64, labels[b]);
+  }
+}
+
+void diagPageLoop() {
+  int pages = 2 + screenCount;
+  if (page >= pages) page = 0;
+  if (appPressedRepeat(BUTTON_PIN_UP)) page = (page + pages - 1) % pages;
+  if (appPressedRepeat(BUTTON_PIN_DOWN)) page = (page + 1) % pages;
+  if (appPressed(BUTTON_PIN_RIGHT)) diagSetEnabled(!diagOn);
+
+  if (!appRedraw()) return;
+  appInvalidateIn(500);
+
+  char line[32];
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_5x8_tr);
+  snprintf(line, sizeof(line), "Diag %d/%d", page + 1, pages);
+  u8g2.drawStr(0, 8, line);
+  u8g2.drawStr(100, 8, diagOn ? "[on]" : "[off]");
+  u8g2.drawHLine(0, 10, 128);
+
+  if (page == 0) drawHeapPage(line, sizeof(line));
+  else if (page == 1) drawProbePage(line, sizeof(line));
+  else drawScreenPage(screens[page - 2], line, sizeof(line));
+
+  u8g2.sendBuffer();
+}
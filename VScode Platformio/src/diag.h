@@ -0,0 +1,93 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef diag_H
+#define diag_H
+
+#include <Arduino.h>
+
+// Instrumentation: scoped cycle-counter probes, per-screen loop time
+// histograms, and heap / task stack watermarks.
+//
+// DIAG=0 (build_flags) compiles every probe out. With the default DIAG=1 the
+// probes are built in but only record while diagnostics are switched on
+// ("diag on" on serial, or RIGHT on the diagnostics page); switched off, a
+// probe costs one load and a branch. The diagnostics page is opened by
+// holding LEFT on the menu.
+#ifndef DIAG
+#define DIAG 1
+#endif
+
+#define DIAG_HIST_BUCKETS  8      // frame time: <1, <2, <4 ... <64, >=64 ms
+#define DIAG_MAX_SCREENS   24
+#define DIAG_HIST_AGE      4096   // halve a histogram at this many frames
+
+struct DiagProbe {
+  const char *name;
+  uint32_t count;
+  uint64_t totalCycles;
+  uint32_t maxCycles;
+  DiagProbe *next;
+  bool listed;
+};
+
+extern volatile bool diagOn;
+
+void diagProbeAdd(DiagProbe &probe, uint32_t cycles);
+
+// Times its own lifetime with the CPU cycle counter. Probes on tasks that are
+// not pinned to a core can be skewed by a core switch inside the scope.
+class DiagScope {
+public:
+  explicit DiagScope(DiagProbe &probe)
+    : probe(probe), active(diagOn), start(active ? ESP.getCycleCount() : 0) {}
+  ~DiagScope() {
+    if (active) diagProbeAdd(probe, ESP.getCycleCount() - start);
+  }
+
+private:
+  DiagProbe &probe;
+  bool active;
+  uint32_t start;
+};
+
+#if DIAG
+#define DIAG_CONCAT2(a, b) a##b
+#define DIAG_CONCAT(a, b) DIAG_CONCAT2(a, b)
+// Times the rest of the enclosing block; name must be a literal
+#define DIAG_SCOPE(name) \
+  static DiagProbe DIAG_CONCAT(diagProbe_, __LINE__) = { name, 0, 0, 0, nullptr, false }; \
+  DiagScope DIAG_CONCAT(diagScope_, __LINE__)(DIAG_CONCAT(diagProbe_, __LINE__))
+#else
+#define DIAG_SCOPE(name) do {} while (0)
+#endif
+
+// Heap allocation counter for the UI task. The esp32dev-allocprobe build
+// (platformio.ini) sets ALLOC_PROBE=1 and links malloc, calloc and realloc
+// through counting wrappers, which also catches String and operator new. The
+// app runtime reports the count per screen when it exits.
+#ifndef ALLOC_PROBE
+#define ALLOC_PROBE 0
+#endif
+
+// Call from the task to watch (the app runtime's setup)
+void diagAllocWatch();
+uint32_t diagAllocs();      // always 0 without ALLOC_PROBE
+
+void diagSetEnabled(bool on);
+void diagReset();
+
+// One frame of a screen, fed by the app runtime while diagnostics are on
+void diagFrame(const char *screen, uint32_t us);
+
+void diagDump();
+// Serial command "diag [on|off|reset]"; false if cmd is not a diag command
+bool diagCommand(const char *cmd);
+
+// Hidden diagnostics page
+void diagPageSetup();
+void diagPageLoop();
+
+#endif
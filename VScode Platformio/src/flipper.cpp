@@ -10,6 +10,10 @@
 #include <BLEScan.h>
 #include <BLEAdvertisedDevice.h>
 #include "flipper.h"
+#include "bledevices.h"
+#include "bletrack.h"
+#include "app.h"
+#include "fmt.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -19,118 +23,82 @@ extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 #define BUTTON_PIN_LEFT   25  // Back
 #define BUTTON_PIN_RIGHT  27  // Select
 
-static int selectedIndex = 0;
-static int displayStartIndex = 0;
+static uint16_t listOrder[BLE_MAX_DEVICES];
+static ListView list;
 static bool showDetails = false;
-static BLEAdvertisedDevice selectedDevice;
+static bool showGraph = false;
 
-const String FLIPPER_MAC_PREFIX_1 = "80:e1:26";
-const String FLIPPER_MAC_PREFIX_2 = "80:e1:27";
+// Flipper Zero OUIs 80:e1:26 and 80:e1:27
+static bool isFlipper(const uint8_t *addr) {
+  return addr[0] == 0x80 && addr[1] == 0xE1 && (addr[2] == 0x26 || addr[2] == 0x27);
+}
 
 void flipperSetup() {
   BLEDevice::init("");
-  BLEScan* scan = BLEDevice::getScan();
-  scan->setActiveScan(true);
 
-  selectedIndex = 0;
-  displayStartIndex = 0;
+  listInit(list, bledevicesCount, bledevicesListRow, bledevicesListKey, BLE_LIST_SORTS,
+           listOrder, BLE_MAX_DEVICES);
   showDetails = false;
+  showGraph = false;
 
   u8g2.setFont(u8g2_font_6x10_tr);
 
-  pinMode(BUTTON_PIN_UP, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_DOWN, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_CENTER, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_LEFT, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_RIGHT, INPUT_PULLUP);
-
-  for (int cycle = 0; cycle < 3; cycle++) {
-    for (int i = 0; i < 3; i++) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_ncenB08_tr);
-      u8g2.drawStr(0, 10, "Scanning Flippers");
-      String dots = "";
-      for (int j = 0; j <= i; j++) dots += " .";
-      u8g2.drawStr(75, 10, dots.c_str());
- 
-      u8g2.sendBuffer();
-      delay(300);
+  // Fills the device table in the background with the selected profile
+  bledevicesStart(5, isFlipper);
+}
+
+void flipperStop() {
+  bletrackStop();
+  bledevicesStop();
+}
+
+void flipperLoop() {
+  static const char *const dots[] = { " .", " . .", " . . ." };
+  bledevicesPoll();
+  int deviceCount = bledevicesCount();
+
+  if (!showDetails) {
+    listUpdate(list);     // the list is redrawn every frame anyway
+
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_6x10_tr);
+    if (deviceCount > 0) {
+      char header[FMT_LINE];
+      fmt(header, sizeof(header), "Flipper Devices: %d", deviceCount);
+      u8g2.drawStr(0, 10, header);
+    } else if (bledevicesScanning()) {
+      u8g2.drawStr(0, 10, "Flipper Devices:");
+      u8g2.drawStr(96, 10, dots[(millis() / 300) % 3]);
+    } else {
+      u8g2.drawStr(0, 10, "Flipper Devices: None");
     }
-  }
 
-  BLEScanResults results = scan->start(5, false);
-  scan->stop();
+    listDraw(list, 20);
 
-  std::vector<BLEAdvertisedDevice> flipperDevices;
-  for (int i = 0; i < results.getCount(); i++) {
-    String mac = String(results.getDevice(i).getAddress().toString().c_str());
-    if (mac.startsWith(FLIPPER_MAC_PREFIX_1) || mac.startsWith(FLIPPER_MAC_PREFIX_2)) {
-      flipperDevices.push_back(results.getDevice(i));
-    }
-  }
+    u8g2.sendBuffer();
 
-  while (true) {
-    if (digitalRead(BUTTON_PIN_CENTER) == LOW) {
-      while (digitalRead(BUTTON_PIN_CENTER) == LOW);
-      return;
+    BleDevice selected;
+    if (appPressed(BUTTON_PIN_RIGHT) && bledevicesGet(listSelected(list), selected)) {
+      // whitelisted active scan: only this device gets scan requests
+      bletrackStart(selected);
+      showDetails = true;
+      showGraph = false;
     }
 
-    if (!showDetails) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_6x10_tr);
-      String header = flipperDevices.size() > 0 ? "Flipper Devices: " + String(flipperDevices.size()) : "Flipper Devices: None";
-      u8g2.drawStr(0, 10, header.c_str());
-
-      for (int i = 0; i < 5 && i + displayStartIndex < flipperDevices.size(); i++) {
-        BLEAdvertisedDevice device = flipperDevices[i + displayStartIndex];
-        String name = device.getName().c_str();
-        if (name.length() == 0) name = "No Name";
-        String info = name.substring(0, 7) + " | RSSI " + String(device.getRSSI());
-        if ((i + displayStartIndex) == selectedIndex) u8g2.drawStr(0, 20 + i * 10, ">");
-        u8g2.drawStr(10, 20 + i * 10, info.c_str());
-      }
-
-      u8g2.sendBuffer();
-
-      if (digitalRead(BUTTON_PIN_UP) == LOW) {
-        if (selectedIndex > 0) selectedIndex--;
-        if (selectedIndex < displayStartIndex) displayStartIndex--;
-        delay(200);
-      }
-
-      if (digitalRead(BUTTON_PIN_DOWN) == LOW) {
-        if (selectedIndex < flipperDevices.size() - 1) selectedIndex++;
-        if (selectedIndex >= displayStartIndex + 5) displayStartIndex++;
-        delay(200);
-      }
-
-      if (digitalRead(BUTTON_PIN_RIGHT) == LOW) {
-        selectedDevice = flipperDevices[selectedIndex];
-        showDetails = true;
-        delay(200);
-      }
+  } else if (showGraph) {
+    bletrackDraw();
 
-    } else {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_6x10_tr);
-      u8g2.drawStr(0, 10, "Device Details:");
-      u8g2.setFont(u8g2_font_5x8_tr);
-      u8g2.drawStr(0, 20, ("Name: " + String(selectedDevice.getName().c_str())).c_str());
-      u8g2.drawStr(0, 30, ("Addr: " + String(selectedDevice.getAddress().toString().c_str())).c_str());
-      u8g2.drawStr(0, 40, ("RSSI: " + String(selectedDevice.getRSSI())).c_str());
-      u8g2.drawStr(0, 50, "Press LEFT to go back");
-      u8g2.sendBuffer();
-
-      if (digitalRead(BUTTON_PIN_LEFT) == LOW) {
-        while (digitalRead(BUTTON_PIN_LEFT) == LOW);
-        showDetails = false;
-        delay(200);
-      }
-
-      if (digitalRead(BUTTON_PIN_CENTER) == LOW) {
-        while (digitalRead(BUTTON_PIN_CENTER) == LOW);
-        return;
-      }
+    if (appPressed(BUTTON_PIN_LEFT)) showGraph = false;
+
+  } else {
+    if (bletrackChanged()) appInvalidate();
+    if (appRedraw()) bletrackDrawDetails();
+
+    if (appPressed(BUTTON_PIN_RIGHT)) showGraph = true;
+
+    if (appPressed(BUTTON_PIN_LEFT)) {
+      bletrackStop();
+      showDetails = false;
     }
   }
-}
\ No newline at end of file
+}
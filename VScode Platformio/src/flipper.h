@@ -17,5 +17,7 @@
 #include "esp_wifi.h"
 
 void flipperSetup();
+void flipperLoop();
+void flipperStop();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "fmt.h"
+
+// snprintf() returns the length it wanted; clamp it to what fits
+static size_t written(int n, size_t size) {
+  if (n < 0 || size == 0) return 0;
+  return (size_t)n < size ? (size_t)n : size - 1;
+}
+
+size_t fmt(char *out, size_t size, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(out, size, format, args);
+  va_end(args);
+  return written(n, size);
+}
+
+size_t fmtMac(char *out, size_t size, const uint8_t *mac) {
+  static const char hex[] = "0123456789abcdef";
+  char buf[FMT_MAC_LEN];
+  for (int i = 0; i < 6; i++) {
+    buf[i * 3]     = hex[mac[i] >> 4];
+    buf[i * 3 + 1] = hex[mac[i] & 0x0F];
+    buf[i * 3 + 2] = (i < 5) ? ':' : '\0';
+  }
+  return fmt(out, size, "%s", buf);
+}
+
+size_t fmtName(char *out, size_t size, const char *name, size_t maxChars, const char *placeholder) {
+  if (!name || !name[0]) name = placeholder;
+  return fmt(out, size, "%.*s", (int)maxChars, name);
+}
+
+size_t fmtScanRow(char *out, size_t size, const char *name, int rssi) {
+  size_t len = fmtName(out, size, name, 7);
+  return len + fmt(out + len, size - len, " | RSSI %d", rssi);
+}
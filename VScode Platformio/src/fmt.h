@@ -0,0 +1,36 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef fmt_H
+#define fmt_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocation-free text formatting for the screens.
+//
+// Every row is built in a char array on the stack and handed to drawStr().
+// Nothing here touches the heap, unlike Arduino String, which allocates for
+// every concatenation and fragments the heap during long scans. The output
+// is always NUL terminated and silently cut at the buffer size. Every
+// function returns the length actually written.
+//
+// Avoid %f with fmt(): newlib's float conversion allocates.
+
+#define FMT_LINE     32     // a full 128 px row in the narrowest (4 px) font
+#define FMT_MAC_LEN  18     // "aa:bb:cc:dd:ee:ff" + NUL
+
+size_t fmt(char *out, size_t size, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Lowercase, colon separated
+size_t fmtMac(char *out, size_t size, const uint8_t *mac);
+
+// At most maxChars of name, or placeholder when name is empty
+size_t fmtName(char *out, size_t size, const char *name, size_t maxChars, const char *placeholder = "No Name");
+
+// List row used by the scan screens: "<name, 7 chars> | RSSI <rssi>"
+size_t fmtScanRow(char *out, size_t size, const char *name, int rssi);
+
+#endif
@@ -0,0 +1,90 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef hll_H
+#define hll_H
+
+// HyperLogLog cardinality sketch with 4-bit registers packed two per byte.
+// tools/hllbench.cpp checks its estimates against exact counts.
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define HLL_P      7
+#define HLL_M      (1 << HLL_P)          // 128 registers, ~9% standard error
+#define HLL_BYTES  (HLL_M / 2)           // 64 bytes per sketch
+#define HLL_RMAX   15                    // largest rank a nibble can hold
+
+struct HllSketch {
+  uint8_t reg[HLL_BYTES];
+};
+
+static inline void hllClear(HllSketch &s) {
+  memset(s.reg, 0, sizeof(s.reg));
+}
+
+static inline uint8_t hllGet(const HllSketch &s, int i) {
+  uint8_t b = s.reg[i >> 1];
+  return (i & 1) ? (b >> 4) : (b & 0x0F);
+}
+
+static inline void hllSet(HllSketch &s, int i, uint8_t v) {
+  uint8_t &b = s.reg[i >> 1];
+  b = (i & 1) ? (uint8_t)((b & 0x0F) | (v << 4)) : (uint8_t)((b & 0xF0) | v);
+}
+
+// splitmix64 finalizer: cheap and good enough to spread 48-bit addresses
+static inline uint64_t hllMix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static inline uint64_t hllHashAddr(const uint8_t addr[6]) {
+  uint64_t x = 0;
+  for (int i = 0; i < 6; i++) x = (x << 8) | addr[i];
+  return hllMix(x);
+}
+
+static inline void hllAdd(HllSketch &s, uint64_t hash) {
+  int idx = (int)(hash >> (64 - HLL_P));
+  uint64_t w = hash << HLL_P;
+  uint8_t rank = 1;
+  while (rank < HLL_RMAX && !(w & 0x8000000000000000ULL)) {
+    rank++;
+    w <<= 1;
+  }
+  if (rank > hllGet(s, idx)) hllSet(s, idx, rank);
+}
+
+// Register-wise max: the union of both sets
+static inline void hllMerge(HllSketch &dst, const HllSketch &src) {
+  for (int i = 0; i < HLL_BYTES; i++) {
+    uint8_t a = dst.reg[i], b = src.reg[i];
+    uint8_t lo = (a & 0x0F) > (b & 0x0F) ? (a & 0x0F) : (b & 0x0F);
+    uint8_t hi = (a & 0xF0) > (b & 0xF0) ? (a & 0xF0) : (b & 0xF0);
+    dst.reg[i] = hi | lo;
+  }
+}
+
+static inline uint32_t hllEstimate(const HllSketch &s) {
+  float sum = 0.0f;
+  int zeros = 0;
+  for (int i = 0; i < HLL_M; i++) {
+    uint8_t r = hllGet(s, i);
+    sum += ldexpf(1.0f, -r);
+    if (r == 0) zeros++;
+  }
+  const float m = (float)HLL_M;
+  const float alpha = 0.7213f / (1.0f + 1.079f / m);
+  float e = alpha * m * m / sum;
+  // small range: linear counting is far more accurate while registers are empty
+  if (e <= 2.5f * m && zeros > 0) e = m * logf(m / (float)zeros);
+  return (uint32_t)(e + 0.5f);
+}
+
+#endif
@@ -0,0 +1,368 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+// Generated by tools/xbm2tiles.py from icon.h, do not edit
+// 38 bitmaps, 13456 B as XBM, 2440 B stored
+
+#include <Arduino.h>
+#include "icon_tiles.h"
+#if !TILE_BLIT
+#include "icon.h"
+#endif
+
+// 'bitmap_icon_apple', 16x16, 32 B as XBM, 24 B packed
+static const uint8_t tile_icon_apple_data [] PROGMEM = {
+  0x81, 0x00, 0x00, 0xc0, 0x81, 0xe0, 0x04, 0xc0, 0xcc, 0xee, 0xe6, 0x60, 0x85, 0x00, 0x01, 0x0f,
+  0x1f, 0x84, 0x3f, 0x01, 0x3c, 0x18, 0x81, 0x00,
+};
+const TileImage tile_icon_apple = { 16, 16, 24, tile_icon_apple_data, TILE_XBM(bitmap_icon_apple) };
+
+// 'bitmap_icon_spoofer', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_spoofer_data [] PROGMEM = {
+  0x00, 0x00, 0x18, 0x38, 0x70, 0xe0, 0xfe, 0xcc, 0x58, 0x30, 0x80, 0x00, 0x30, 0xe0, 0x00, 0x00,
+  0x00, 0x00, 0x18, 0x1c, 0x0e, 0x07, 0x7f, 0x33, 0x1a, 0x0c, 0x01, 0x00, 0x0c, 0x07, 0x00, 0x00,
+};
+const TileImage tile_icon_spoofer = { 16, 16, 0, tile_icon_spoofer_data, TILE_XBM(bitmap_icon_spoofer) };
+
+// 'bitmap_icon_ble_jammer', 16x16, 32 B as XBM, 26 B packed
+static const uint8_t tile_icon_ble_jammer_data [] PROGMEM = {
+  0x81, 0x00, 0x07, 0x08, 0x18, 0x30, 0x60, 0xc0, 0x9c, 0x08, 0x70, 0x87, 0x00, 0x0b, 0x18, 0x0c,
+  0x06, 0x03, 0x3f, 0x13, 0x0e, 0x0c, 0x18, 0x30, 0x00, 0x00,
+};
+const TileImage tile_icon_ble_jammer = { 16, 16, 26, tile_icon_ble_jammer_data, TILE_XBM(bitmap_icon_ble_jammer) };
+
+// 'bitmap_icon_jammer', 16x16, 32 B as XBM, 29 B packed
+static const uint8_t tile_icon_jammer_data [] PROGMEM = {
+  0x81, 0x00, 0x82, 0xcc, 0x05, 0x98, 0x18, 0x30, 0x70, 0xe0, 0xc0, 0x82, 0x00, 0x00, 0x18, 0x81,
+  0x3c, 0x0a, 0x18, 0x01, 0x03, 0x1f, 0x1c, 0x00, 0x00, 0x1f, 0x1f, 0x00, 0x00,
+};
+const TileImage tile_icon_jammer = { 16, 16, 29, tile_icon_jammer_data, TILE_XBM(bitmap_icon_jammer) };
+
+// 'bitmap_icon_scanner', 16x16, 32 B as XBM, 26 B packed
+static const uint8_t tile_icon_scanner_data [] PROGMEM = {
+  0x87, 0x00, 0x80, 0xfe, 0x80, 0x00, 0x80, 0xf0, 0x80, 0x00, 0x80, 0x3f, 0x80, 0x00, 0x80, 0x30,
+  0x80, 0x00, 0x80, 0x3f, 0x80, 0x00, 0x80, 0x3f, 0x00, 0x00,
+};
+const TileImage tile_icon_scanner = { 16, 16, 26, tile_icon_scanner_data, TILE_XBM(bitmap_icon_scanner) };
+
+// 'bitmap_icon_analyzer', 16x16, 32 B as XBM, 30 B packed
+static const uint8_t tile_icon_analyzer_data [] PROGMEM = {
+  0x83, 0x00, 0x1a, 0xc0, 0xc2, 0x8a, 0x2a, 0x2a, 0xca, 0x12, 0xe4, 0x08, 0xf0, 0x00, 0x00, 0x40,
+  0x60, 0x50, 0x58, 0x57, 0x5f, 0x57, 0x67, 0x46, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00,
+};
+const TileImage tile_icon_analyzer = { 16, 16, 30, tile_icon_analyzer_data, TILE_XBM(bitmap_icon_analyzer) };
+
+// 'bitmap_icon_colorcube', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_colorcube_data [] PROGMEM = {
+  0x00, 0xf8, 0x08, 0x04, 0x04, 0x02, 0x02, 0xff, 0x01, 0x02, 0x02, 0x04, 0x04, 0x08, 0xf8, 0x00,
+  0x00, 0x0f, 0x08, 0x10, 0x10, 0x20, 0x20, 0x7f, 0x40, 0x20, 0x20, 0x10, 0x10, 0x08, 0x0f, 0x00,
+};
+const TileImage tile_icon_colorcube = { 16, 16, 0, tile_icon_colorcube_data, TILE_XBM(bitmap_icon_colorcube) };
+
+// 'bitmap_icon_colorpicker', 16x16, 32 B as XBM, 27 B packed
+static const uint8_t tile_icon_colorpicker_data [] PROGMEM = {
+  0x81, 0x00, 0x07, 0xff, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x86, 0x00, 0x0c, 0xff, 0x80,
+  0x40, 0x20, 0x10, 0x20, 0x40, 0x80, 0x99, 0x6a, 0x0c, 0x00, 0x00,
+};
+const TileImage tile_icon_colorpicker = { 16, 16, 27, tile_icon_colorpicker_data, TILE_XBM(bitmap_icon_colorpicker) };
+
+// 'bitmap_icon_about', 16x16, 32 B as XBM, 27 B packed
+static const uint8_t tile_icon_about_data [] PROGMEM = {
+  0x81, 0x00, 0x02, 0x80, 0x8c, 0x92, 0x82, 0xa1, 0x02, 0x92, 0x8c, 0x80, 0x82, 0x00, 0x03, 0x3e,
+  0x41, 0x40, 0x78, 0x84, 0x40, 0x04, 0x78, 0x40, 0x41, 0x3e, 0x00,
+};
+const TileImage tile_icon_about = { 16, 16, 27, tile_icon_about_data, TILE_XBM(bitmap_icon_about) };
+
+// 'bitmap_icon_ble', 16x16, 32 B as XBM, 22 B packed
+static const uint8_t tile_icon_ble_data [] PROGMEM = {
+  0x82, 0x00, 0x06, 0x20, 0x40, 0x80, 0xfe, 0x84, 0x48, 0x30, 0x87, 0x00, 0x06, 0x04, 0x02, 0x01,
+  0x7f, 0x21, 0x12, 0x0c, 0x83, 0x00,
+};
+const TileImage tile_icon_ble = { 16, 16, 22, tile_icon_ble_data, TILE_XBM(bitmap_icon_ble) };
+
+// 'bitmap_icon_wifi', 16x16, 32 B as XBM, 29 B packed
+static const uint8_t tile_icon_wifi_data [] PROGMEM = {
+  0x05, 0x20, 0x30, 0x98, 0xc8, 0x4c, 0x64, 0x82, 0x24, 0x05, 0x64, 0x4c, 0xc8, 0x98, 0x30, 0x20,
+  0x82, 0x00, 0x07, 0x04, 0x06, 0x02, 0x33, 0x33, 0x02, 0x06, 0x04, 0x82, 0x00,
+};
+const TileImage tile_icon_wifi = { 16, 16, 29, tile_icon_wifi_data, TILE_XBM(bitmap_icon_wifi) };
+
+// 'bitmap_icon_kill', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_kill_data [] PROGMEM = {
+  0x00, 0x00, 0xc0, 0x60, 0x38, 0x38, 0x3c, 0xfc, 0xfc, 0x3c, 0x38, 0x38, 0x60, 0xc0, 0x00, 0x00,
+  0x00, 0x00, 0x07, 0x0c, 0x78, 0x78, 0x1c, 0x67, 0x67, 0x1c, 0x78, 0x78, 0x0c, 0x07, 0x00, 0x00,
+};
+const TileImage tile_icon_kill = { 16, 16, 0, tile_icon_kill_data, TILE_XBM(bitmap_icon_kill) };
+
+// 'bitmap_icon_question', 16x16, 32 B as XBM, 27 B packed
+static const uint8_t tile_icon_question_data [] PROGMEM = {
+  0x0d, 0x00, 0x18, 0x3c, 0x3e, 0x3e, 0x1f, 0x8f, 0x87, 0x87, 0xcf, 0xff, 0xfe, 0xfe, 0x7c, 0x85,
+  0x00, 0x00, 0x63, 0x81, 0xf7, 0x02, 0x63, 0x01, 0x01, 0x82, 0x00,
+};
+const TileImage tile_icon_question = { 16, 16, 27, tile_icon_question_data, TILE_XBM(bitmap_icon_question) };
+
+// 'bitmap_icon_save', 16x16, 32 B as XBM, 26 B packed
+static const uint8_t tile_icon_save_data [] PROGMEM = {
+  0x03, 0xfe, 0xff, 0x7f, 0x60, 0x83, 0x5f, 0x80, 0x51, 0x08, 0x5f, 0x60, 0x7f, 0xf7, 0xfe, 0x7f,
+  0xff, 0xc0, 0xdf, 0x86, 0xd5, 0x03, 0xdf, 0xc0, 0xff, 0x7f,
+};
+const TileImage tile_icon_save = { 16, 16, 26, tile_icon_save_data, TILE_XBM(bitmap_icon_save) };
+
+// 'bitmap_icon_skull', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_skull_data [] PROGMEM = {
+  0xf0, 0xfc, 0xfe, 0x9e, 0x0f, 0x0f, 0x9f, 0xff, 0xff, 0x9f, 0x0f, 0x0f, 0x9e, 0xfe, 0xfc, 0xf0,
+  0x00, 0x01, 0x0f, 0x0f, 0x7f, 0x7f, 0x0f, 0x7f, 0x7f, 0x0f, 0x7f, 0x7f, 0x0f, 0x0f, 0x01, 0x00,
+};
+const TileImage tile_icon_skull = { 16, 16, 0, tile_icon_skull_data, TILE_XBM(bitmap_icon_skull) };
+
+// 'bitmap_icon_setting', 16x16, 32 B as XBM, 31 B packed
+static const uint8_t tile_icon_setting_data [] PROGMEM = {
+  0x05, 0xc0, 0xc8, 0xdc, 0xfe, 0xfc, 0x38, 0x82, 0x1f, 0x0b, 0x38, 0xfc, 0xfe, 0xdc, 0xc8, 0xc0,
+  0x03, 0x13, 0x3b, 0x7f, 0x3f, 0x1c, 0x82, 0xf8, 0x05, 0x1c, 0x3f, 0x7f, 0x3b, 0x13, 0x03,
+};
+const TileImage tile_icon_setting = { 16, 16, 31, tile_icon_setting_data, TILE_XBM(bitmap_icon_setting) };
+
+// 'bitmap_icon_signal', 16x16, 32 B as XBM, 30 B packed
+static const uint8_t tile_icon_signal_data [] PROGMEM = {
+  0x04, 0x38, 0x7c, 0x3c, 0x3e, 0x9e, 0x84, 0x9f, 0x14, 0x9e, 0x3e, 0x3c, 0x7c, 0x38, 0x00, 0x00,
+  0x03, 0x0f, 0x67, 0xe7, 0x73, 0x33, 0x33, 0x73, 0xe7, 0x67, 0x0f, 0x03, 0x00, 0x00,
+};
+const TileImage tile_icon_signal = { 16, 16, 30, tile_icon_signal_data, TILE_XBM(bitmap_icon_signal) };
+
+// 'bitmap_icon_brain', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_brain_data [] PROGMEM = {
+  0xc0, 0xe0, 0xec, 0xee, 0xdf, 0xfb, 0xfb, 0xf6, 0x00, 0x7f, 0xbf, 0xbf, 0x7e, 0xfc, 0xe0, 0xc0,
+  0x03, 0x07, 0x3f, 0x7e, 0xf6, 0xf9, 0xfb, 0x77, 0x00, 0xff, 0xff, 0xef, 0x77, 0x17, 0x07, 0x03,
+};
+const TileImage tile_icon_brain = { 16, 16, 0, tile_icon_brain_data, TILE_XBM(bitmap_icon_brain) };
+
+// 'bitmap_icon_stat', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_stat_data [] PROGMEM = {
+  0xfe, 0xff, 0x03, 0x83, 0x03, 0x03, 0x03, 0xe3, 0x1b, 0x63, 0x83, 0x03, 0x83, 0x63, 0xff, 0xfe,
+  0x7f, 0xff, 0xc6, 0xc1, 0xc6, 0xd8, 0xc7, 0xc0, 0xc0, 0xc0, 0xc1, 0xc6, 0xc1, 0xc0, 0xff, 0x7f,
+};
+const TileImage tile_icon_stat = { 16, 16, 0, tile_icon_stat_data, TILE_XBM(bitmap_icon_stat) };
+
+// 'bitmap_icon_sword', 16x16, 32 B as XBM, 29 B packed
+static const uint8_t tile_icon_sword_data [] PROGMEM = {
+  0x80, 0x00, 0x80, 0x80, 0x80, 0x00, 0x13, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0x7c, 0x3e, 0x1f, 0x0f,
+  0x07, 0xe0, 0xe0, 0xf1, 0x3b, 0x17, 0x0e, 0x1d, 0x3b, 0x33, 0x01, 0x84, 0x00,
+};
+const TileImage tile_icon_sword = { 16, 16, 29, tile_icon_sword_data, TILE_XBM(bitmap_icon_sword) };
+
+// 'bitmap_icon_character', 16x16, 32 B as XBM, 27 B packed
+static const uint8_t tile_icon_character_data [] PROGMEM = {
+  0x83, 0x00, 0x05, 0x3e, 0x73, 0x7f, 0x7f, 0x73, 0x3e, 0x83, 0x00, 0x03, 0xe0, 0xf8, 0xfc, 0x3c,
+  0x81, 0xfe, 0x80, 0xff, 0x81, 0xfe, 0x03, 0x3c, 0xfc, 0xf8, 0xe0,
+};
+const TileImage tile_icon_character = { 16, 16, 27, tile_icon_character_data, TILE_XBM(bitmap_icon_character) };
+
+// 'bitmap_icon_follow', 16x16, 32 B as XBM, 32 B raw
+static const uint8_t tile_icon_follow_data [] PROGMEM = {
+  0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x00, 0x00, 0x00, 0xc6, 0xef, 0xff, 0xff, 0xef, 0xc6, 0x00,
+  0x78, 0xfd, 0xff, 0xff, 0xfd, 0x78, 0x00, 0x60, 0x60, 0x68, 0x6c, 0x7e, 0x3e, 0x0c, 0x08, 0x00,
+};
+const TileImage tile_icon_follow = { 16, 16, 0, tile_icon_follow_data, TILE_XBM(bitmap_icon_follow) };
+
+// 'bitmap_icon_dialog', 16x16, 32 B as XBM, 28 B packed
+static const uint8_t tile_icon_dialog_data [] PROGMEM = {
+  0x04, 0xf8, 0xfc, 0xae, 0xae, 0xee, 0x83, 0xae, 0x00, 0xbe, 0x81, 0xae, 0x03, 0xfc, 0xf8, 0x07,
+  0x0f, 0x84, 0x1e, 0x02, 0x3e, 0x7f, 0xfe, 0x81, 0x1e, 0x01, 0x0f, 0x07,
+};
+const TileImage tile_icon_dialog = { 16, 16, 28, tile_icon_dialog_data, TILE_XBM(bitmap_icon_dialog) };
+
+// 'bitmap_icon_key', 16x16, 32 B as XBM, 23 B packed
+static const uint8_t tile_icon_key_data [] PROGMEM = {
+  0x81, 0x00, 0x02, 0x3c, 0x7e, 0xe7, 0x82, 0xc3, 0x02, 0xe7, 0x7e, 0x3c, 0x88, 0x00, 0x80, 0xfe,
+  0x03, 0x00, 0xf8, 0xd8, 0xd8, 0x81, 0x00,
+};
+const TileImage tile_icon_key = { 16, 16, 23, tile_icon_key_data, TILE_XBM(bitmap_icon_key) };
+
+// 'logo_cifer', 128x64, 1024 B as XBM, 330 B packed
+static const uint8_t tile_logo_cifer_data [] PROGMEM = {
+  0xb7, 0x00, 0x8a, 0x80, 0x02, 0x90, 0x10, 0x10, 0x81, 0x20, 0x04, 0x60, 0x40, 0x40, 0x80, 0x80,
+  0xcf, 0x00, 0x80, 0x30, 0x80, 0x70, 0x81, 0xf0, 0x80, 0xe0, 0x00, 0xc0, 0x84, 0x00, 0x06, 0x08,
+  0x1c, 0x96, 0x86, 0xc2, 0xe3, 0xe1, 0x81, 0xf1, 0x82, 0xf8, 0x80, 0x00, 0x81, 0xf8, 0x80, 0xf9,
+  0x80, 0xf1, 0x08, 0xf3, 0xe3, 0xe2, 0xc6, 0xc4, 0x86, 0x02, 0x01, 0x01, 0x82, 0x00, 0x02, 0x80,
+  0xc0, 0xe0, 0x81, 0xf0, 0x81, 0x70, 0x80, 0x30, 0xbc, 0x00, 0x08, 0x1c, 0x3c, 0xf8, 0xf0, 0xf0,
+  0xe0, 0xe0, 0xf0, 0xfb, 0x83, 0xff, 0x05, 0x7e, 0x1c, 0xe4, 0xf0, 0xfc, 0xfe, 0x8b, 0xff, 0x80,
+  0x00, 0x8c, 0xff, 0x05, 0xfe, 0xfc, 0xf8, 0xe0, 0x8c, 0x3e, 0x83, 0xff, 0x00, 0xf8, 0x82, 0xf0,
+  0x02, 0xf8, 0x78, 0x3c, 0xbe, 0x00, 0x86, 0x01, 0x80, 0x03, 0x00, 0xf8, 0x90, 0xff, 0x80, 0x00,
+  0x81, 0xff, 0x00, 0x7f, 0x85, 0x3f, 0x82, 0x7f, 0x82, 0xff, 0x02, 0xfe, 0x00, 0x03, 0x85, 0x01,
+  0xc2, 0x00, 0x81, 0x80, 0x80, 0xc0, 0x80, 0x80, 0x03, 0xc0, 0xe0, 0xe0, 0x00, 0x84, 0xff, 0x06,
+  0x7f, 0x3f, 0xbf, 0x9f, 0x9f, 0x3f, 0x7f, 0x83, 0xff, 0x80, 0x00, 0x80, 0xff, 0x02, 0xf8, 0xe0,
+  0x80, 0x88, 0x00, 0x0a, 0x80, 0xe1, 0xff, 0xff, 0x1f, 0xe0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0x81,
+  0xc0, 0x80, 0x80, 0xbd, 0x00, 0x08, 0x3c, 0x1e, 0x1f, 0x0f, 0x0f, 0x07, 0x07, 0x0f, 0x9f, 0x82,
+  0xff, 0x17, 0x7e, 0x38, 0x03, 0x0f, 0x1f, 0x3f, 0x3f, 0x30, 0x63, 0xcf, 0x9f, 0x7f, 0xff, 0xfe,
+  0xfc, 0xfb, 0xe7, 0xcf, 0x9f, 0x00, 0x00, 0xbf, 0x9f, 0xcf, 0x81, 0xe7, 0x0d, 0xce, 0x9c, 0x3c,
+  0xf8, 0xf8, 0x7c, 0x7c, 0x3e, 0x3f, 0x1f, 0x1f, 0x07, 0x11, 0x3c, 0x83, 0xff, 0x00, 0x8f, 0x81,
+  0x07, 0x80, 0x0f, 0x01, 0x1f, 0x1e, 0xbe, 0x00, 0x02, 0x04, 0x0c, 0x0e, 0x81, 0x0f, 0x80, 0x07,
+  0x01, 0x03, 0x01, 0x88, 0x00, 0x05, 0x03, 0x0f, 0x9e, 0xdd, 0xe3, 0xe7, 0x87, 0xff, 0x06, 0xe7,
+  0xc3, 0xd9, 0xbc, 0x1e, 0x07, 0x01, 0x88, 0x00, 0x03, 0x01, 0x03, 0x07, 0x07, 0x81, 0x0f, 0x02,
+  0x0e, 0x06, 0x04, 0xd5, 0x00, 0x07, 0x03, 0x07, 0x0f, 0x0f, 0x07, 0x07, 0x03, 0x01, 0x81, 0x00,
+  0x00, 0x01, 0x81, 0x03, 0x02, 0x07, 0x03, 0x03, 0xb5, 0x00,
+};
+const TileImage tile_logo_cifer = { 128, 64, 330, tile_logo_cifer_data, TILE_XBM(logo_cifer) };
+
+// 'bitmap_scrollbar_background', 8x64, 64 B as XBM, 33 B packed
+static const uint8_t tile_scrollbar_background_data [] PROGMEM = {
+  0x84, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x00, 0xaa,
+  0x85, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x00, 0xaa, 0x85, 0x00, 0x01, 0x2a,
+  0x00,
+};
+const TileImage tile_scrollbar_background = { 8, 64, 33, tile_scrollbar_background_data, TILE_XBM(bitmap_scrollbar_background) };
+
+// 'bitmap_item_sel_outline', 128x21, 336 B as XBM, 29 B packed
+static const uint8_t tile_item_sel_outline_data [] PROGMEM = {
+  0x02, 0x00, 0xfc, 0x02, 0xf5, 0x01, 0x01, 0xfe, 0xfc, 0x83, 0x00, 0x00, 0xff, 0xf6, 0x00, 0x80,
+  0xff, 0x83, 0x00, 0x01, 0x07, 0x08, 0xf5, 0x18, 0x01, 0x0f, 0x07, 0x82, 0x00,
+};
+const TileImage tile_item_sel_outline = { 128, 21, 29, tile_item_sel_outline_data, TILE_XBM(bitmap_item_sel_outline) };
+
+// 'bitmap_arrow_left', 128x64, 1024 B as XBM, 45 B packed
+static const uint8_t tile_arrow_left_data [] PROGMEM = {
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x80, 0x80, 0x0a, 0xc0, 0xe0, 0xe0, 0xf0, 0xf8, 0xf8, 0xfc,
+  0xfc, 0xfe, 0xff, 0xff, 0xf0, 0x00, 0x80, 0x03, 0x07, 0x07, 0x0f, 0x0f, 0x1f, 0x1f, 0x3f, 0x7f,
+  0x7f, 0x82, 0xff, 0xfb, 0x00, 0x81, 0x01, 0xff, 0x00, 0xff, 0x00, 0xec, 0x00,
+};
+const TileImage tile_arrow_left = { 128, 64, 45, tile_arrow_left_data, TILE_XBM(bitmap_arrow_left) };
+
+// 'bitmap_arrow_right', 128x64, 1024 B as XBM, 46 B packed
+static const uint8_t tile_arrow_right_data [] PROGMEM = {
+  0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xeb, 0x00, 0x81, 0xff, 0x0a, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0,
+  0xf0, 0xe0, 0xc0, 0xc0, 0x80, 0x80, 0xf0, 0x00, 0x83, 0xff, 0x80, 0x7f, 0x06, 0x3f, 0x1f, 0x1f,
+  0x0f, 0x07, 0x07, 0x03, 0xf0, 0x00, 0x81, 0x01, 0xff, 0x00, 0xff, 0x00, 0x89, 0x00,
+};
+const TileImage tile_arrow_right = { 128, 64, 46, tile_arrow_right_data, TILE_XBM(bitmap_arrow_right) };
+
+// 'bitmap_ble_jammer', 128x64, 1024 B as XBM, 111 B packed
+static const uint8_t tile_ble_jammer_data [] PROGMEM = {
+  0xff, 0x00, 0xbb, 0x00, 0x80, 0xe0, 0x01, 0xc0, 0x80, 0xfa, 0x00, 0x80, 0xff, 0x0b, 0x13, 0x03,
+  0x07, 0x0f, 0x1e, 0x3c, 0x38, 0x78, 0xf0, 0xe0, 0xc0, 0xc0, 0xe7, 0x00, 0x16, 0x06, 0x0f, 0x1e,
+  0x1c, 0x38, 0x78, 0xf0, 0xe0, 0xe0, 0xff, 0xff, 0xe0, 0xe0, 0xf0, 0x78, 0x38, 0x1c, 0x1e, 0x0f,
+  0x07, 0x03, 0x03, 0x01, 0xe7, 0x00, 0x15, 0xc0, 0xe0, 0xf0, 0x70, 0x38, 0x3c, 0x1e, 0x0f, 0x0f,
+  0xff, 0xff, 0x0f, 0x0f, 0x1e, 0x3c, 0x38, 0x70, 0xf0, 0xe0, 0xc0, 0x80, 0x80, 0xe9, 0x00, 0x00,
+  0x01, 0x85, 0x00, 0x80, 0xff, 0x0b, 0x90, 0x80, 0xc0, 0xe0, 0xf0, 0x78, 0x38, 0x3d, 0x1f, 0x0f,
+  0x07, 0x07, 0xf0, 0x00, 0x80, 0x0f, 0x03, 0x07, 0x03, 0x01, 0x01, 0xff, 0x00, 0xb9, 0x00,
+};
+const TileImage tile_ble_jammer = { 128, 64, 111, tile_ble_jammer_data, TILE_XBM(bitmap_ble_jammer) };
+
+// 'bitmap_bluetooth_jammer', 128x64, 1024 B as XBM, 148 B packed
+static const uint8_t tile_bluetooth_jammer_data [] PROGMEM = {
+  0xff, 0x00, 0xb7, 0x00, 0x81, 0xe0, 0x01, 0xc0, 0x80, 0xee, 0x00, 0x06, 0x30, 0x70, 0xf8, 0xf0,
+  0xe0, 0xc0, 0x80, 0x82, 0x00, 0x82, 0xff, 0x08, 0x1f, 0x3f, 0x7e, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0,
+  0x80, 0x84, 0x00, 0x01, 0x80, 0xc0, 0xe1, 0x00, 0x07, 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3e, 0x7c,
+  0xf8, 0x82, 0xff, 0x13, 0xf8, 0xfc, 0x7e, 0x3f, 0x1f, 0x0f, 0x07, 0x83, 0xc1, 0xe0, 0xf0, 0xe0,
+  0x00, 0x00, 0x01, 0x0f, 0xff, 0xff, 0xfc, 0xe0, 0xde, 0x00, 0x07, 0x80, 0xc0, 0xe0, 0xf0, 0xf8,
+  0xfc, 0x7e, 0x3f, 0x82, 0xff, 0x13, 0x3f, 0x3e, 0x7c, 0xf8, 0xf0, 0xe0, 0xc0, 0x81, 0x03, 0x07,
+  0x0f, 0x07, 0x00, 0x00, 0x80, 0xe0, 0xff, 0xff, 0x7f, 0x07, 0xdb, 0x00, 0x07, 0x0c, 0x1e, 0x3f,
+  0x1f, 0x0f, 0x07, 0x03, 0x01, 0x81, 0x00, 0x82, 0xff, 0x08, 0xf0, 0xf8, 0x7c, 0x3f, 0x1f, 0x0f,
+  0x07, 0x03, 0x01, 0x84, 0x00, 0x02, 0x01, 0x03, 0x01, 0xe8, 0x00, 0x81, 0x0f, 0x01, 0x03, 0x01,
+  0xff, 0x00, 0xbe, 0x00,
+};
+const TileImage tile_bluetooth_jammer = { 128, 64, 148, tile_bluetooth_jammer_data, TILE_XBM(bitmap_bluetooth_jammer) };
+
+// 'bitmap_cctv', 128x64, 1024 B as XBM, 161 B packed
+static const uint8_t tile_cctv_data [] PROGMEM = {
+  0xff, 0x00, 0xb4, 0x00, 0x05, 0x80, 0xc0, 0xe0, 0xc0, 0xc0, 0x80, 0xf2, 0x00, 0x17, 0xc0, 0xe0,
+  0xf0, 0x78, 0x1e, 0x0f, 0x07, 0x03, 0x00, 0x00, 0x01, 0x03, 0x07, 0x07, 0x0e, 0x1c, 0x1c, 0x38,
+  0x70, 0xe0, 0xe0, 0xc0, 0x80, 0x80, 0xe4, 0x00, 0x0a, 0x06, 0x0f, 0x1f, 0x1d, 0x38, 0x70, 0xf0,
+  0xe0, 0xc0, 0x80, 0x80, 0x8a, 0x00, 0x0d, 0x01, 0x03, 0x07, 0x87, 0xce, 0xdc, 0x1c, 0x38, 0x70,
+  0xe0, 0xe0, 0xc0, 0x80, 0x80, 0xd5, 0x00, 0x02, 0xe0, 0xf0, 0x60, 0x83, 0x00, 0x11, 0x80, 0x98,
+  0xfc, 0xff, 0xe7, 0xe3, 0xc3, 0x87, 0x8e, 0x1e, 0x1c, 0xf8, 0xf0, 0xf0, 0xe0, 0xc0, 0xc0, 0x80,
+  0x81, 0x00, 0x0d, 0x80, 0xc0, 0xe0, 0xe0, 0x70, 0x38, 0x1c, 0x1e, 0x0f, 0x8f, 0xdf, 0xf9, 0x78,
+  0x30, 0xd3, 0x00, 0x80, 0xff, 0x83, 0xe7, 0x80, 0x63, 0x05, 0x73, 0x31, 0x38, 0x1c, 0x1c, 0x0f,
+  0x83, 0x07, 0x05, 0x01, 0x00, 0x00, 0x01, 0x03, 0x03, 0x81, 0x07, 0x80, 0x03, 0x80, 0x07, 0x06,
+  0x0e, 0x1c, 0x1c, 0x1e, 0x0f, 0x07, 0x03, 0xd6, 0x00, 0x02, 0x07, 0x0f, 0x02, 0xff, 0x00, 0xcf,
+  0x00,
+};
+const TileImage tile_cctv = { 128, 64, 161, tile_cctv_data, TILE_XBM(bitmap_cctv) };
+
+// 'bitmap_logo_flip', 128x64, 1024 B as XBM, 98 B packed
+static const uint8_t tile_logo_flip_data [] PROGMEM = {
+  0xbc, 0x00, 0x84, 0xf8, 0xf8, 0x00, 0x84, 0xff, 0xef, 0x00, 0x01, 0x0c, 0xfe, 0x81, 0xfc, 0x00,
+  0xfe, 0x81, 0x00, 0x84, 0xff, 0x81, 0x00, 0x83, 0xf0, 0x00, 0xe0, 0x81, 0x00, 0x80, 0x80, 0xd6,
+  0x00, 0x84, 0xe0, 0x84, 0x00, 0x83, 0xff, 0x81, 0xe0, 0x84, 0xff, 0x81, 0xe0, 0x83, 0xff, 0x02,
+  0x9c, 0x00, 0x00, 0x81, 0xff, 0x81, 0xfc, 0xd3, 0x00, 0x81, 0x07, 0x81, 0x3f, 0x80, 0xff, 0x03,
+  0x7f, 0x00, 0x00, 0x20, 0x9d, 0xff, 0xd9, 0x00, 0x81, 0x0f, 0x80, 0xfe, 0x9b, 0xff, 0x81, 0x7f,
+  0xdc, 0x00, 0x04, 0x03, 0x01, 0x43, 0x7f, 0x7f, 0x96, 0xff, 0x80, 0x7f, 0xe4, 0x00, 0x95, 0x1f,
+  0xaf, 0x00,
+};
+const TileImage tile_logo_flip = { 128, 64, 98, tile_logo_flip_data, TILE_XBM(bitmap_logo_flip) };
+
+// 'bitmap_nrf24', 128x64, 1024 B as XBM, 137 B packed
+static const uint8_t tile_nrf24_data [] PROGMEM = {
+  0xff, 0x00, 0xb5, 0x00, 0x81, 0xf8, 0x00, 0xf0, 0xf3, 0x00, 0x00, 0x80, 0x81, 0xc0, 0x81, 0x00,
+  0x82, 0xff, 0x80, 0x00, 0x03, 0xf8, 0xfc, 0xfc, 0xf8, 0x87, 0x00, 0x03, 0xf8, 0xfc, 0xfc, 0xf8,
+  0xda, 0x00, 0x05, 0xc0, 0xe0, 0xe0, 0xc0, 0x00, 0x00, 0x82, 0xff, 0x81, 0x00, 0x82, 0xff, 0x80,
+  0x00, 0x82, 0xff, 0x80, 0x00, 0x03, 0xf8, 0xfc, 0xfe, 0xfc, 0x81, 0x00, 0x82, 0xff, 0x80, 0x00,
+  0x00, 0xc0, 0x81, 0xe0, 0xd4, 0x00, 0x81, 0x07, 0x02, 0x03, 0x00, 0x00, 0x82, 0xff, 0x81, 0x00,
+  0x82, 0xff, 0x80, 0x00, 0x82, 0xff, 0x80, 0x00, 0x03, 0x1f, 0x7f, 0x7f, 0x3f, 0x81, 0x00, 0x82,
+  0xff, 0x80, 0x00, 0x00, 0x03, 0x81, 0x07, 0xda, 0x00, 0x00, 0x01, 0x81, 0x03, 0x81, 0x00, 0x82,
+  0xff, 0x80, 0x00, 0x03, 0x1f, 0x3f, 0x3f, 0x1f, 0x87, 0x00, 0x03, 0x1f, 0x3f, 0x3f, 0x1f, 0xe7,
+  0x00, 0x81, 0x1f, 0x00, 0x0f, 0xff, 0x00, 0xc1, 0x00,
+};
+const TileImage tile_nrf24 = { 128, 64, 137, tile_nrf24_data, TILE_XBM(bitmap_nrf24) };
+
+// 'bitmap_rc', 128x64, 1024 B as XBM, 196 B packed
+static const uint8_t tile_rc_data [] PROGMEM = {
+  0xff, 0x00, 0xad, 0x00, 0x06, 0x80, 0xc0, 0xc0, 0xe0, 0xc0, 0xc0, 0x80, 0x82, 0x00, 0x80, 0x80,
+  0x84, 0xc0, 0x80, 0x80, 0x82, 0x00, 0x06, 0x80, 0xc0, 0xc0, 0xe0, 0xc0, 0xc0, 0x80, 0xde, 0x00,
+  0x80, 0xff, 0x04, 0x81, 0x80, 0x80, 0xff, 0xff, 0x81, 0x00, 0x0b, 0x01, 0x03, 0x03, 0x01, 0x19,
+  0x38, 0x38, 0x19, 0x01, 0x03, 0x03, 0x01, 0x81, 0x00, 0x80, 0xff, 0x80, 0x80, 0x02, 0x81, 0xff,
+  0xff, 0xd9, 0x00, 0x80, 0xf0, 0x81, 0x70, 0x80, 0x7f, 0x81, 0x73, 0x80, 0x7f, 0x83, 0x70, 0x07,
+  0x7c, 0x3e, 0x0e, 0x06, 0x06, 0x0e, 0x3e, 0x7c, 0x83, 0x70, 0x80, 0x7f, 0x81, 0x73, 0x80, 0x7f,
+  0x81, 0x70, 0x80, 0xf0, 0xd4, 0x00, 0x80, 0xff, 0x81, 0x00, 0x0b, 0xe0, 0xf8, 0x3c, 0x1c, 0x0e,
+  0x7e, 0x7e, 0x0e, 0x0c, 0x3c, 0xf8, 0xf0, 0x81, 0x00, 0x80, 0x30, 0x81, 0x00, 0x0b, 0xf0, 0xf8,
+  0xfc, 0xdc, 0xce, 0xce, 0x0e, 0x0e, 0x1c, 0x7c, 0xf8, 0xe0, 0x81, 0x00, 0x80, 0xff, 0xd4, 0x00,
+  0x80, 0xff, 0x81, 0x00, 0x0b, 0x03, 0x07, 0x0f, 0x1c, 0x18, 0x38, 0x38, 0x18, 0x1c, 0x1e, 0x0f,
+  0x03, 0x81, 0x00, 0x80, 0x06, 0x81, 0x00, 0x0b, 0x03, 0x0f, 0x1f, 0x1d, 0x19, 0x39, 0x38, 0x18,
+  0x1c, 0x0f, 0x07, 0x03, 0x81, 0x00, 0x80, 0xff, 0xd4, 0x00, 0x00, 0x03, 0xa6, 0x07, 0x00, 0x03,
+  0xff, 0x00, 0xa8, 0x00,
+};
+const TileImage tile_rc = { 128, 64, 196, tile_rc_data, TILE_XBM(bitmap_rc) };
+
+// 'bitmap_usb', 128x64, 1024 B as XBM, 99 B packed
+static const uint8_t tile_usb_data [] PROGMEM = {
+  0xff, 0x00, 0xba, 0x00, 0x05, 0x80, 0xc0, 0xe0, 0xf0, 0xe0, 0x80, 0xf6, 0x00, 0x03, 0x08, 0x0c,
+  0x0f, 0x1f, 0x81, 0xff, 0x80, 0x0f, 0x01, 0x0c, 0x80, 0x84, 0xc0, 0xe7, 0x00, 0x09, 0xf8, 0xfc,
+  0xfc, 0xfe, 0xfe, 0xfc, 0xfc, 0xf0, 0x00, 0x00, 0x81, 0xff, 0x81, 0x00, 0x01, 0x8f, 0xdf, 0x81,
+  0xff, 0x01, 0x1f, 0x0f, 0xe8, 0x00, 0x08, 0x01, 0x1f, 0x3f, 0x7f, 0xfb, 0xe1, 0xe0, 0xc0, 0xc0,
+  0x81, 0xff, 0x06, 0x1e, 0x0f, 0x0f, 0x07, 0x03, 0x03, 0x01, 0xf1, 0x00, 0x02, 0x81, 0xe3, 0xf3,
+  0x81, 0xff, 0x01, 0xf0, 0xe0, 0xf6, 0x00, 0x01, 0x01, 0x07, 0x82, 0x0f, 0x01, 0x07, 0x03, 0xff,
+  0x00, 0xb9, 0x00,
+};
+const TileImage tile_usb = { 128, 64, 99, tile_usb_data, TILE_XBM(bitmap_usb) };
+
+// 'bitmap_wifi_jammer', 128x64, 1024 B as XBM, 126 B packed
+static const uint8_t tile_wifi_jammer_data [] PROGMEM = {
+  0xff, 0x00, 0xff, 0x00, 0xaa, 0x00, 0x0d, 0x80, 0xc0, 0xe0, 0xe0, 0xf0, 0x78, 0x78, 0x38, 0x3c,
+  0x1c, 0x1e, 0x1e, 0x0e, 0x0e, 0x87, 0x0f, 0x80, 0x0e, 0x80, 0x1e, 0x0a, 0x1c, 0x3c, 0x3c, 0x78,
+  0x78, 0xf0, 0xf0, 0xe0, 0xc0, 0x80, 0x80, 0xd6, 0x00, 0x10, 0x02, 0x07, 0x07, 0x03, 0x01, 0x01,
+  0xc0, 0xe0, 0xe0, 0xf0, 0x78, 0x78, 0x3c, 0x3c, 0x1c, 0x1e, 0x1e, 0x85, 0x0e, 0x80, 0x1e, 0x0e,
+  0x1c, 0x3c, 0x3c, 0x78, 0x78, 0xf0, 0xe0, 0xe0, 0xc0, 0x01, 0x01, 0x03, 0x07, 0x07, 0x03, 0xdb,
+  0x00, 0x81, 0x01, 0x80, 0x00, 0x07, 0x40, 0xf0, 0xf0, 0x78, 0x3c, 0x3c, 0x1c, 0x1c, 0x82, 0x1e,
+  0x08, 0x1c, 0x3c, 0x3c, 0x78, 0xf0, 0xf0, 0x60, 0x00, 0x00, 0x81, 0x01, 0xec, 0x00, 0x01, 0x70,
+  0xf8, 0x81, 0xfc, 0x01, 0xf8, 0x70, 0xf9, 0x00, 0x81, 0x01, 0xff, 0x00, 0xbb, 0x00,
+};
+const TileImage tile_wifi_jammer = { 128, 64, 126, tile_wifi_jammer_data, TILE_XBM(bitmap_wifi_jammer) };
+
+// 'bitmap_zigbee', 128x64, 1024 B as XBM, 196 B packed
+static const uint8_t tile_zigbee_data [] PROGMEM = {
+  0xff, 0x00, 0xab, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0xc0, 0x9b, 0x00, 0x03, 0xc0, 0xe0, 0xc0, 0x80,
+  0xd5, 0x00, 0x10, 0xc0, 0xf0, 0xfc, 0x3e, 0x0f, 0x07, 0x81, 0xe0, 0xf0, 0x78, 0x3c, 0x1c, 0x00,
+  0x80, 0xc0, 0xc0, 0x80, 0x89, 0x00, 0x10, 0x80, 0xc0, 0xc0, 0x80, 0x00, 0x1c, 0x3c, 0x78, 0xf0,
+  0xe0, 0x81, 0x07, 0x0f, 0x3e, 0xfc, 0xf0, 0xc0, 0xd0, 0x00, 0x2e, 0xfe, 0xff, 0xff, 0x01, 0x00,
+  0x00, 0xfc, 0xff, 0xff, 0x03, 0x00, 0x00, 0xf8, 0xff, 0xff, 0x07, 0x01, 0x00, 0x20, 0xf8, 0xfc,
+  0x8e, 0x0e, 0x06, 0x0e, 0x8e, 0xfc, 0xf8, 0x20, 0x00, 0x01, 0x07, 0xff, 0xff, 0xf8, 0x00, 0x00,
+  0x03, 0xff, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xff, 0xff, 0xfe, 0xcf, 0x00, 0x15, 0x03, 0x3f, 0xff,
+  0xf8, 0xc0, 0x00, 0x03, 0x1f, 0x7f, 0xfc, 0xf0, 0xc0, 0x81, 0x07, 0x1f, 0x3e, 0x38, 0x10, 0x00,
+  0x01, 0x03, 0x03, 0x81, 0xff, 0x80, 0x03, 0x13, 0x01, 0x00, 0x10, 0x38, 0x3e, 0x1f, 0x07, 0x81,
+  0xc0, 0xf0, 0xfc, 0x7f, 0x1f, 0x01, 0x00, 0xc0, 0xf8, 0xff, 0x3f, 0x03, 0xd2, 0x00, 0x09, 0x03,
+  0x07, 0x0f, 0x3e, 0x38, 0x30, 0x00, 0x01, 0x03, 0x03, 0x87, 0x00, 0x81, 0xff, 0x87, 0x00, 0x80,
+  0x03, 0x07, 0x01, 0x00, 0x30, 0x38, 0x3e, 0x0f, 0x07, 0x03, 0xe8, 0x00, 0x02, 0x07, 0x0f, 0x07,
+  0xff, 0x00, 0xbb, 0x00,
+};
+const TileImage tile_zigbee = { 128, 64, 196, tile_zigbee_data, TILE_XBM(bitmap_zigbee) };
@@ -0,0 +1,52 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+// Generated by tools/xbm2tiles.py from icon.h, do not edit
+
+#ifndef icon_tiles_H
+#define icon_tiles_H
+
+#include "tiles.h"
+
+extern const TileImage tile_icon_apple;         // 16x16
+extern const TileImage tile_icon_spoofer;       // 16x16
+extern const TileImage tile_icon_ble_jammer;    // 16x16
+extern const TileImage tile_icon_jammer;        // 16x16
+extern const TileImage tile_icon_scanner;       // 16x16
+extern const TileImage tile_icon_analyzer;      // 16x16
+extern const TileImage tile_icon_colorcube;     // 16x16
+extern const TileImage tile_icon_colorpicker;   // 16x16
+extern const TileImage tile_icon_about;         // 16x16
+extern const TileImage tile_icon_ble;           // 16x16
+extern const TileImage tile_icon_wifi;          // 16x16
+extern const TileImage tile_icon_kill;          // 16x16
+extern const TileImage tile_icon_question;      // 16x16
+extern const TileImage tile_icon_save;          // 16x16
+extern const TileImage tile_icon_skull;         // 16x16
+extern const TileImage tile_icon_setting;       // 16x16
+extern const TileImage tile_icon_signal;        // 16x16
+extern const TileImage tile_icon_brain;         // 16x16
+extern const TileImage tile_icon_stat;          // 16x16
+extern const TileImage tile_icon_sword;         // 16x16
+extern const TileImage tile_icon_character;     // 16x16
+extern const TileImage tile_icon_follow;        // 16x16
+extern const TileImage tile_icon_dialog;        // 16x16
+extern const TileImage tile_icon_key;           // 16x16
+extern const TileImage tile_logo_cifer;         // 128x64
+extern const TileImage tile_scrollbar_background;// 8x64
+extern const TileImage tile_item_sel_outline;   // 128x21
+extern const TileImage tile_arrow_left;         // 128x64
+extern const TileImage tile_arrow_right;        // 128x64
+extern const TileImage tile_ble_jammer;         // 128x64
+extern const TileImage tile_bluetooth_jammer;   // 128x64
+extern const TileImage tile_cctv;               // 128x64
+extern const TileImage tile_logo_flip;          // 128x64
+extern const TileImage tile_nrf24;              // 128x64
+extern const TileImage tile_rc;                 // 128x64
+extern const TileImage tile_usb;                // 128x64
+extern const TileImage tile_wifi_jammer;        // 128x64
+extern const TileImage tile_zigbee;             // 128x64
+
+#endif
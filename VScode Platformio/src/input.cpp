@@ -0,0 +1,158 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "driver/gpio.h"
+#include "input.h"
+
+struct PinState {
+  uint8_t  pin;
+  bool     down;           // debounced level
+  bool     settling;       // edge reported, waiting for the bounce to end
+  bool     longSent;
+  uint32_t downMs;
+  uint32_t nextRepeatMs;
+};
+
+static PinState pinState[INPUT_MAX_PINS];
+static int pinCount = 0;
+
+static QueueHandle_t events = nullptr;
+static TimerHandle_t settleTimer = nullptr;
+static portMUX_TYPE stateMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t dropped = 0;
+
+static void IRAM_ATTR edgeIsr(void *arg) {
+  PinState &s = pinState[(int)(intptr_t)arg];
+  BaseType_t woken = pdFALSE;
+  bool report = false;
+  InputEvent ev;
+
+  portENTER_CRITICAL_ISR(&stateMux);
+  if (!s.settling) {
+    // leading edge: report now, ignore the bounce until the timer fires
+    bool down = gpio_get_level((gpio_num_t)s.pin) == 0;
+    if (down != s.down) {
+      s.down = down;
+      s.longSent = false;
+      s.downMs = millis();
+      ev.pin = s.pin;
+      ev.type = down ? INPUT_PRESS : INPUT_RELEASE;
+      ev.ms = s.downMs;
+      report = true;
+    }
+    s.settling = true;
+  }
+  portEXIT_CRITICAL_ISR(&stateMux);
+
+  if (report && xQueueSendFromISR(events, &ev, &woken) != pdTRUE) dropped++;
+  xTimerResetFromISR(settleTimer, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+static void push(uint8_t pin, uint8_t type, uint32_t ms) {
+  InputEvent ev = { pin, type, ms };
+  if (xQueueSend(events, &ev, 0) != pdTRUE) dropped++;
+}
+
+// Timer task: the pins have been quiet for INPUT_DEBOUNCE_MS
+static void settle(TimerHandle_t) {
+  uint32_t now = millis();
+  bool anyDown = false;
+
+  for (int i = 0; i < pinCount; i++) {
+    PinState &s = pinState[i];
+    bool down = digitalRead(s.pin) == LOW;
+    bool changed = false;
+    bool sendLong = false;
+    bool sendRepeat = false;
+
+    portENTER_CRITICAL(&stateMux);
+    s.settling = false;
+    if (down != s.down) {
+      // the bounce ended on the other level (or a short tap was missed)
+      s.down = down;
+      s.longSent = false;
+      s.downMs = now;
+      changed = true;
+    } else if (down && !s.longSent && now - s.downMs >= INPUT_LONG_MS) {
+      s.longSent = true;
+      s.nextRepeatMs = s.downMs + INPUT_LONG_MS + INPUT_REPEAT_MS;
+      sendLong = true;
+    } else if (down && s.longSent && (int32_t)(now - s.nextRepeatMs) >= 0) {
+      s.nextRepeatMs += INPUT_REPEAT_MS;
+      sendRepeat = true;
+    }
+    portEXIT_CRITICAL(&stateMux);
+
+    if (changed) push(s.pin, down ? INPUT_PRESS : INPUT_RELEASE, now);
+    if (sendLong) push(s.pin, INPUT_LONG, now);
+    if (sendRepeat) push(s.pin, INPUT_REPEAT, now);
+    anyDown |= down;
+  }
+
+  // keep timing long-press / repeat while something is held
+  if (anyDown) xTimerStart(settleTimer, 0);
+}
+
+void inputSetup(const uint8_t *pins, int count) {
+  if (count > INPUT_MAX_PINS) count = INPUT_MAX_PINS;
+
+  events = xQueueCreate(INPUT_QUEUE_DEPTH, sizeof(InputEvent));
+  settleTimer = xTimerCreate("input", pdMS_TO_TICKS(INPUT_DEBOUNCE_MS), pdFALSE, nullptr, settle);
+
+  pinCount = count;
+  for (int i = 0; i < count; i++) {
+    PinState &s = pinState[i];
+    pinMode(pins[i], INPUT_PULLUP);
+    s.pin = pins[i];
+    s.down = false;        // a button held through boot reports nothing until it is let go
+    s.settling = false;
+    s.longSent = false;
+    s.downMs = 0;
+    s.nextRepeatMs = 0;
+    attachInterruptArg(digitalPinToInterrupt(pins[i]), edgeIsr, (void *)(intptr_t)i, CHANGE);
+  }
+}
+
+bool inputPoll(InputEvent &ev) {
+  return events && xQueueReceive(events, &ev, 0) == pdTRUE;
+}
+
+bool inputDown(uint8_t pin) {
+  for (int i = 0; i < pinCount; i++) {
+    if (pinState[i].pin == pin) return pinState[i].down;
+  }
+  return false;
+}
+
+uint32_t inputDropped() {
+  return dropped;
+}
+
+bool inputSleepPrepare() {
+  for (int i = 0; i < pinCount; i++) {
+    if (pinState[i].down || pinState[i].settling) return false;
+  }
+  for (int i = 0; i < pinCount; i++) {
+    gpio_num_t pin = (gpio_num_t)pinState[i].pin;
+    gpio_intr_disable(pin);
+    gpio_wakeup_enable(pin, GPIO_INTR_LOW_LEVEL);
+  }
+  return true;
+}
+
+void inputSleepResume() {
+  for (int i = 0; i < pinCount; i++) {
+    gpio_num_t pin = (gpio_num_t)pinState[i].pin;
+    gpio_wakeup_disable(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+    gpio_intr_enable(pin);
+  }
+  xTimerReset(settleTimer, 0);
+}
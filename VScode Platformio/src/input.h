@@ -0,0 +1,59 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef input_H
+#define input_H
+
+#include <stdint.h>
+
+// Interrupt-driven button driver.
+//
+// Every button edge raises a GPIO interrupt. The first edge of a quiet pin is
+// reported straight from the ISR, and the bounce that follows is absorbed by a
+// one-shot FreeRTOS timer that fires once the pin has been quiet for
+// INPUT_DEBOUNCE_MS and corrects the level if it settled the other way. While
+// a button is held the timer keeps re-arming itself to produce long-press and
+// auto-repeat events; with nothing held no GPIO is read at all.
+// Events land in a queue that the UI task drains (app.cpp does it per frame).
+
+#define INPUT_MAX_PINS          8
+#define INPUT_QUEUE_DEPTH       16
+#define INPUT_DEBOUNCE_MS       15
+#define INPUT_LONG_MS           500    // held this long: one INPUT_LONG
+#define INPUT_REPEAT_MS         100    // ... then INPUT_REPEAT at this rate
+
+enum InputEventType : uint8_t {
+  INPUT_PRESS,
+  INPUT_RELEASE,
+  INPUT_LONG,
+  INPUT_REPEAT
+};
+
+struct InputEvent {
+  uint8_t  pin;
+  uint8_t  type;       // InputEventType
+  uint32_t ms;         // millis() when the edge was seen
+};
+
+// Pins are active low with the internal pull-up enabled
+void inputSetup(const uint8_t *pins, int count);
+
+// Non-blocking; false when the queue is empty
+bool inputPoll(InputEvent &ev);
+
+// Current debounced level
+bool inputDown(uint8_t pin);
+
+// Events lost because the queue was full
+uint32_t inputDropped();
+
+// Light sleep support (power.cpp). Prepare swaps the edge interrupts for
+// low-level wakeups and returns false, changing nothing, while a button is
+// held. Resume restores the edge interrupts and re-reads the levels through
+// the settle timer, so a press that caused the wakeup is still reported.
+bool inputSleepPrepare();
+void inputSleepResume();
+
+#endif
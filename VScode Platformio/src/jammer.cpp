@@ -5,6 +5,7 @@
    
 #include <Arduino.h> 
 #include "jammer.h"
+#include "app.h"
 
 #define BT1 33  // channels
 #define BT2 26  // data rate
@@ -121,51 +122,36 @@ void jammer() {
   }
 }
 
-void pressBt01() {
-    static unsigned long last_interrupt_time = 0;
-    unsigned long interrupt_time = millis();
-    if (interrupt_time - last_interrupt_time > 200) {
+// Buttons arrive through the app runtime's input queue (input.h)
+void handleJammerButtons() {
+    if (appPressed(BT1)) {
         if (channels < 14) {
             channels++;
         } else {
             channels = 1;
         }
-        //Serial.print("Channel: ");
-        //Serial.println(channels);
     }
-    last_interrupt_time = interrupt_time;
-}
-
-void pressBt02() {
-    static unsigned long last_interrupt_time = 0;
-    unsigned long interrupt_time = millis();
-    if (interrupt_time - last_interrupt_time > 200) {
+    if (appPressed(BT2)) {
         jamming = !jamming;
-        //Serial.println(jamming ? "Jamming started" : "Jamming stopped");
+        // the modules only draw TX current while jamming
+        if (jamming) {
+            radioA.powerUp();
+            radioB.powerUp();
+            radioC.powerUp();
+        } else {
+            radioA.powerDown();
+            radioB.powerDown();
+            radioC.powerDown();
+        }
     }
-    last_interrupt_time = interrupt_time;
-}
-
-void pressBt03() {
-    static unsigned long last_interrupt_time = 0;
-    unsigned long interrupt_time = millis();
-    if (interrupt_time - last_interrupt_time > 200) {
+    if (appPressed(BT3)) {
         dataRateIndex = (dataRateIndex + 1) % 3; // Cycle through data rates
         setRadioParameters();
-        //Serial.println("Data rate changed");
     }
-    last_interrupt_time = interrupt_time;
-}
-
-void pressBt04() {
-    static unsigned long last_interrupt_time = 0;
-    unsigned long interrupt_time = millis();
-    if (interrupt_time - last_interrupt_time > 200) {
+    if (appPressed(BT4)) {
         paLevelIndex = (paLevelIndex + 1) % 4; // Cycle through power levels
         setRadioParameters();
-        //Serial.println("Power level changed");
     }
-    last_interrupt_time = interrupt_time;
 }
 
 void configure(RF24 &radio) {
@@ -182,15 +168,6 @@ void configure(RF24 &radio) {
 
 void jammerSetup(){
     Serial.begin(115200);
-    
-    esp_bt_controller_deinit();
-    esp_wifi_stop();
-    esp_wifi_deinit();
-    
-    pinMode(BT1, INPUT_PULLUP);
-    pinMode(BT2, INPUT_PULLUP);
-    pinMode(BT3, INPUT_PULLUP);  
-    pinMode(BT4, INPUT_PULLUP);  
 
     SPI.begin();
     
@@ -209,18 +186,28 @@ void jammerSetup(){
 
     //radio.begin();
     setRadioParameters();
+
+    // idle until jamming is switched on
+    jamming = false;
+    radioA.powerDown();
+    radioB.powerDown();
+    radioC.powerDown();
     //radio.openWritingPipe(address);
     //radio.stopListening();
 
     //Serial.println("Radio configured and ready");  
 }
 
+void jammerStop(){
+    jamming = false;
+    radioA.powerDown();
+    radioB.powerDown();
+    radioC.powerDown();
+}
+
 
 void jammerLoop(){
-    attachInterrupt(digitalPinToInterrupt(BT1), pressBt01, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BT2), pressBt02, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BT3), pressBt03, FALLING);
-    attachInterrupt(digitalPinToInterrupt(BT4), pressBt04, FALLING);
+    handleJammerButtons();
 
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_ncenB08_tr);
@@ -15,5 +15,6 @@
 
 void jammerSetup();
 void jammerLoop();
+void jammerStop();
 
 #endif
@@ -0,0 +1,96 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "journal.h"
+#include "app.h"
+
+RTC_NOINIT_ATTR JournalArea journal;
+
+static uint32_t heapMarked = 0;     // heap minimum at the last JOURNAL_HEAP_LOW
+static uint32_t frameCount = 0;
+
+static const char *resetName(uint32_t reason) {
+  static const char *names[] = {
+    "unknown", "power-on", "external", "software", "panic", "interrupt wdt",
+    "task wdt", "other wdt", "deep sleep", "brownout", "sdio"
+  };
+  return reason < sizeof(names) / sizeof(names[0]) ? names[reason] : "?";
+}
+
+static bool valid() {
+  return journal.magic == JOURNAL_MAGIC;
+}
+
+void journalClear() {
+  memset(&journal, 0, sizeof(journal));
+  journal.magic = JOURNAL_MAGIC;
+}
+
+void journalSetup() {
+  esp_reset_reason_t reason = esp_reset_reason();
+  if (!valid()) {
+    journalClear();
+  } else {
+    Serial.printf("journal of the previous run, reset by %s:\n", resetName(reason));
+    journalDump();
+  }
+
+  journal.boots++;
+  journalAdd(JOURNAL_BOOT, nullptr, (uint16_t)journal.boots, reason);
+  heapMarked = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+}
+
+void journalScreen(const char *name, uint32_t freeHeap, uint32_t largestBlock) {
+  journalAdd(JOURNAL_SCREEN, name, (uint16_t)min(largestBlock / 256, (uint32_t)0xFFFF), freeHeap);
+}
+
+void journalFrame(const char *name, uint32_t usedUs) {
+  journal.lastFrameTick = xTaskGetTickCount();
+  journalTag(journal.lastScreen, name);
+
+  if (usedUs > JOURNAL_SLOW_FRAMES * APP_FRAME_MS * 1000UL) journalAdd(JOURNAL_SLOW_FRAME, name, 0, usedUs);
+
+  // the minimum is cheap to read, but once every 32 frames is plenty
+  if ((++frameCount & 31) == 0) {
+    uint32_t minimum = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    if (minimum + JOURNAL_HEAP_STEP <= heapMarked) {
+      heapMarked = minimum;
+      journalAdd(JOURNAL_HEAP_LOW, name, 0, minimum);
+    }
+  }
+}
+
+void journalDump() {
+  uint32_t head = journal.head;
+  uint32_t count = head < JOURNAL_ENTRIES ? head : JOURNAL_ENTRIES;
+  Serial.printf("journal: %u boots, %u entries (%u kept), last frame %u ms in %.4s\n",
+                (unsigned)journal.boots, (unsigned)head, (unsigned)count,
+                (unsigned)journal.lastFrameTick, journal.lastScreen);
+
+  for (uint32_t i = head - count; i != head; i++) {
+    const JournalEntry &e = journal.entries[i & (JOURNAL_ENTRIES - 1)];
+    Serial.printf("  %9u ms  ", (unsigned)e.tick);
+    switch (e.type) {
+      case JOURNAL_BOOT:
+        Serial.printf("boot #%u, reset by %s\n", (unsigned)e.arg, resetName(e.value));
+        break;
+      case JOURNAL_SCREEN:
+        Serial.printf("screen %-4.4s free %u largest %u\n", e.tag, (unsigned)e.value, (unsigned)e.arg * 256);
+        break;
+      case JOURNAL_HEAP_LOW:
+        Serial.printf("heap   %-4.4s minimum %u\n", e.tag, (unsigned)e.value);
+        break;
+      case JOURNAL_SLOW_FRAME:
+        Serial.printf("slow   %-4.4s %u us\n", e.tag, (unsigned)e.value);
+        break;
+      default:
+        Serial.printf("type %u arg %u value %u\n", (unsigned)e.type, (unsigned)e.arg, (unsigned)e.value);
+        break;
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef journal_H
+#define journal_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Crash-survivable event journal.
+//
+// A ring of fixed 16-byte entries in RTC slow memory (RTC_NOINIT_ATTR),
+// which keeps its contents across panics, watchdog and software resets but
+// not across a power cycle. It records each boot with its reset reason,
+// screen switches with the heap, new heap minimums and slow frames, plus a
+// heartbeat of the last frame. On the next boot the journal left by the
+// previous run is printed on serial before new entries go in, so a screen
+// that hung until the watchdog fired, or ran the heap dry, leaves its trail.
+//
+// An entry costs an atomic increment and a handful of stores. The journal is
+// only valid while the magic matches; anything else (power-on garbage, a
+// layout change) starts it over.
+
+#define JOURNAL_ENTRIES     64          // power of two
+#define JOURNAL_MAGIC       0x4A524E31  // "JRN1"
+#define JOURNAL_SLOW_FRAMES 4           // a tick this many frame periods long is logged
+#define JOURNAL_HEAP_STEP   4096        // log the heap minimum each time it drops this much
+
+enum JournalType : uint16_t {
+  JOURNAL_BOOT = 1,       // arg: boot count, value: esp_reset_reason()
+  JOURNAL_SCREEN,         // arg: largest free block / 256, value: free heap after entering
+  JOURNAL_HEAP_LOW,       // value: minimum free heap so far
+  JOURNAL_SLOW_FRAME,     // value: tick time in us
+};
+
+struct JournalEntry {
+  uint32_t tick;          // xTaskGetTickCount() (ms) in the boot it was written
+  uint16_t type;
+  uint16_t arg;
+  uint32_t value;
+  char     tag[4];        // screen name, first four characters
+};
+
+struct JournalArea {
+  uint32_t magic;
+  uint32_t boots;
+  uint32_t head;          // entries ever written; head % JOURNAL_ENTRIES is the next slot
+  uint32_t lastFrameTick; // heartbeat of the running screen
+  char     lastScreen[4];
+  JournalEntry entries[JOURNAL_ENTRIES];
+};
+
+extern JournalArea journal;
+
+// Up to four characters, NUL padded
+static inline void journalTag(char *out, const char *name) {
+  for (int i = 0; i < 4; i++) {
+    char c = name ? name[i] : '\0';
+    out[i] = c;
+    if (!c) name = nullptr;
+  }
+}
+
+static inline void journalAdd(JournalType type, const char *tag, uint16_t arg, uint32_t value) {
+  JournalEntry &e = journal.entries[__atomic_fetch_add(&journal.head, 1, __ATOMIC_RELAXED) & (JOURNAL_ENTRIES - 1)];
+  e.tick = xTaskGetTickCount();
+  e.type = type;
+  e.arg = arg;
+  e.value = value;
+  journalTag(e.tag, tag);
+}
+
+// First thing in setup(): prints the previous run's journal and records this boot
+void journalSetup();
+
+// App runtime hooks
+void journalScreen(const char *name, uint32_t freeHeap, uint32_t largestBlock);
+void journalFrame(const char *name, uint32_t usedUs);
+
+void journalDump();
+void journalClear();
+
+#endif
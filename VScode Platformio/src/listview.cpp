@@ -0,0 +1,209 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "listview.h"
+#include "app.h"
+#include "fmt.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define BUTTON_PIN_UP    26
+#define BUTTON_PIN_DOWN  33
+#define BUTTON_PIN_LEFT  25
+
+static const char *const sortNames[LIST_SORT_COUNT] = { "scan", "rssi", "name", "seen" };
+
+// Strict order on backing indices; ties keep discovery order
+static bool before(const ListView &list, int a, int b) {
+  if (list.sort == LIST_SORT_NONE) return a < b;
+  uint32_t ka = list.key(a, list.sort);
+  uint32_t kb = list.key(b, list.sort);
+  return ka < kb || (ka == kb && a < b);
+}
+
+// Binary search insertion of entries the source added since the last frame
+static bool placeNew(ListView &list) {
+  int n = list.count();
+  if (n > list.capacity) n = list.capacity;
+  if (n < list.known) listReset(list);   // the source started over
+
+  bool changed = false;
+  for (int k = 0; k < LIST_INSERTS_PER_FRAME && list.known < n; k++) {
+    int index = list.known;
+    int lo = 0, hi = list.known;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (before(list, index, list.order[mid])) hi = mid;
+      else lo = mid + 1;
+    }
+    memmove(&list.order[lo + 1], &list.order[lo], (list.known - lo) * sizeof(list.order[0]));
+    list.order[lo] = index;
+    list.known++;
+    changed = true;
+  }
+  return changed;
+}
+
+// A bounded slice of a shaker sort, for keys that change after insertion
+static bool repair(ListView &list) {
+  if (list.sort == LIST_SORT_NONE || list.known < 2) return false;
+  if (list.sortPos > list.known - 2) list.sortPos = list.known - 2;
+
+  bool changed = false;
+  for (int step = 0; step < LIST_SORT_STEPS; step++) {
+    int i = list.sortPos;
+    if (before(list, list.order[i + 1], list.order[i])) {
+      uint16_t t = list.order[i];
+      list.order[i] = list.order[i + 1];
+      list.order[i + 1] = t;
+      changed = true;
+    }
+    list.sortPos += list.sortDir;
+    if (list.sortPos > list.known - 2) {
+      list.sortPos = list.known - 2;
+      list.sortDir = -1;
+    } else if (list.sortPos < 0) {
+      list.sortPos = 0;
+      list.sortDir = 1;
+    }
+  }
+  return changed;
+}
+
+static int scrollStep(uint16_t repeats) {
+  if (repeats < 10) return 1;
+  if (repeats < 30) return LIST_ROWS;
+  return LIST_FAST_ROWS;
+}
+
+static void nextSort(ListView &list) {
+  for (int i = 1; i < LIST_SORT_COUNT; i++) {
+    uint8_t s = (list.sort + i) % LIST_SORT_COUNT;
+    if (s == LIST_SORT_NONE || (list.key && (list.sorts & (1 << s)))) {
+      list.sort = s;
+      break;
+    }
+  }
+  // everything is placed again under the new key, a slice per frame
+  listReset(list);
+  list.sortChangedMs = millis();
+  appInvalidateIn(LIST_SORT_LABEL_MS);
+}
+
+void listInit(ListView &list, ListCountFn count, ListRowFn row, ListKeyFn key, uint8_t sorts,
+              uint16_t *order, int capacity) {
+  list.count = count;
+  list.row = row;
+  list.key = key;
+  list.sorts = sorts;
+  list.order = order;
+  list.capacity = capacity;
+  list.sort = LIST_SORT_NONE;
+  list.sortChangedMs = 0;
+  listReset(list);
+}
+
+void listReset(ListView &list) {
+  list.known = 0;
+  list.cursor = 0;
+  list.top = 0;
+  list.repeats = 0;
+  list.leftTap = false;
+  list.sortPos = 0;
+  list.sortDir = 1;
+}
+
+bool listUpdate(ListView &list) {
+  int oldCursor = list.cursor;
+  int oldTop = list.top;
+
+  int step = 0;
+  if (appPressed(BUTTON_PIN_UP) || appPressed(BUTTON_PIN_DOWN)) {
+    list.repeats = 0;
+    step = 1;
+  } else if (appPressedRepeat(BUTTON_PIN_UP) || appPressedRepeat(BUTTON_PIN_DOWN)) {
+    step = scrollStep(++list.repeats);
+  }
+  if (appPressedRepeat(BUTTON_PIN_UP)) list.cursor -= step;
+  if (appPressedRepeat(BUTTON_PIN_DOWN)) list.cursor += step;
+
+  // LEFT acts on release, so a hold that turns into a sort change leaves the
+  // cursor where it was
+  if (appPressed(BUTTON_PIN_LEFT)) list.leftTap = true;
+  else if (!appHeld(BUTTON_PIN_LEFT) && !appReleased(BUTTON_PIN_LEFT)) list.leftTap = false;
+  if (appLongPressed(BUTTON_PIN_LEFT)) {
+    list.leftTap = false;
+    nextSort(list);
+  }
+  if (appReleased(BUTTON_PIN_LEFT) && list.leftTap) {
+    list.leftTap = false;
+    list.cursor = list.cursor == 0 ? list.known - 1 : 0;
+  }
+
+  bool changed = placeNew(list);
+  changed |= repair(list);
+
+  if (list.cursor > list.known - 1) list.cursor = list.known - 1;
+  if (list.cursor < 0) list.cursor = 0;
+  if (list.cursor < list.top) list.top = list.cursor;
+  if (list.cursor >= list.top + LIST_ROWS) list.top = list.cursor - LIST_ROWS + 1;
+
+  return changed || list.cursor != oldCursor || list.top != oldTop;
+}
+
+void listDraw(const ListView &list, int y) {
+  for (int i = 0; i < LIST_ROWS && list.top + i < list.known; i++) {
+    char line[FMT_LINE];
+    list.row(list.order[list.top + i], line, sizeof(line));
+    if (list.top + i == list.cursor) u8g2.drawStr(0, y + i * LIST_ROW_HEIGHT, ">");
+    u8g2.drawStr(10, y + i * LIST_ROW_HEIGHT, line);
+  }
+
+  // scrollbar thumb along the right edge
+  if (list.known > LIST_ROWS) {
+    const int height = LIST_ROWS * LIST_ROW_HEIGHT;
+    int thumb = height * LIST_ROWS / list.known;
+    if (thumb < 3) thumb = 3;
+    int pos = (height - thumb) * list.top / (list.known - LIST_ROWS);
+    u8g2.drawBox(126, y - LIST_ROW_HEIGHT + 2 + pos, 2, thumb);
+  }
+
+  if (millis() - list.sortChangedMs < LIST_SORT_LABEL_MS) {
+    char label[FMT_LINE];
+    fmt(label, sizeof(label), "sort: %s", sortNames[list.sort]);
+    int w = u8g2.getStrWidth(label) + 4;
+    int x = (128 - w) / 2;
+    int ly = y + 2 * LIST_ROW_HEIGHT;
+    u8g2.setDrawColor(0);
+    u8g2.drawBox(x - 1, ly - LIST_ROW_HEIGHT, w + 2, LIST_ROW_HEIGHT + 4);
+    u8g2.setDrawColor(1);
+    u8g2.drawFrame(x, ly - LIST_ROW_HEIGHT + 1, w, LIST_ROW_HEIGHT + 2);
+    u8g2.drawStr(x + 2, ly + 1, label);
+  }
+}
+
+int listSelected(const ListView &list) {
+  return list.known ? list.order[list.cursor] : -1;
+}
+
+int listCount(const ListView &list) {
+  return list.known;
+}
+
+uint32_t listNameKey(const char *name) {
+  if (!name || !name[0]) return UINT32_MAX;
+  uint32_t key = 0;
+  for (int i = 0; i < 4; i++) {
+    key <<= 8;
+    if (*name) key |= (uint8_t)tolower(*name++);
+  }
+  return key;
+}
+
+uint32_t listRssiKey(int rssi) {
+  return (uint32_t)(127 - rssi);
+}
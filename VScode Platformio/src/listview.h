@@ -0,0 +1,91 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef listview_H
+#define listview_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Virtualized list widget for the scan screens.
+//
+// The list never holds row data. It keeps a permutation of the source's
+// backing indices (storage provided by the screen), pulls the text of the
+// LIST_ROWS visible rows through a callback into stack buffers, and sorts
+// by a 32-bit key the source computes per entry. Per-frame cost is bounded
+// however long the list grows:
+//  - new entries are placed with a binary search, LIST_INSERTS_PER_FRAME at a time
+//  - keys that drift (RSSI) are repaired by LIST_SORT_STEPS compare-and-swap
+//    steps of a shaker sort per frame
+//  - only the visible rows are formatted and drawn
+//
+// Keys: UP/DOWN move the cursor. Held, they auto-repeat and speed up to a
+// page per step after a second and LIST_FAST_ROWS per step after three.
+// A LEFT tap jumps to the top, or to the bottom when already at the top, on
+// release, once it is clear the press is not a hold. Holding LEFT switches to the next sort key the source supports and shows
+// its name over the list for LIST_SORT_LABEL_MS.
+
+#define LIST_ROWS               5
+#define LIST_ROW_HEIGHT         10
+#define LIST_FAST_ROWS          25
+#define LIST_INSERTS_PER_FRAME  16
+#define LIST_SORT_STEPS         64
+#define LIST_SORT_LABEL_MS      1000
+
+enum ListSort : uint8_t {
+  LIST_SORT_NONE,         // backing order (order of discovery)
+  LIST_SORT_RSSI,         // strongest first
+  LIST_SORT_NAME,         // alphabetical, unnamed last
+  LIST_SORT_SEEN,         // most recently seen first
+  LIST_SORT_COUNT
+};
+
+typedef int      (*ListCountFn)();
+// Row text for a backing index
+typedef void     (*ListRowFn)(int index, char *out, size_t size);
+// Sort key for a backing index; lower keys sort first
+typedef uint32_t (*ListKeyFn)(int index, uint8_t sort);
+
+struct ListView {
+  ListCountFn count;
+  ListRowFn   row;
+  ListKeyFn   key;         // nullptr: LIST_SORT_NONE only
+  uint8_t     sorts;       // bit per ListSort the key supports
+  uint16_t   *order;       // capacity entries, owned by the screen
+  int         capacity;
+
+  int      known;          // backing entries placed in order[]
+  int      cursor;
+  int      top;            // first visible position
+  uint8_t  sort;
+  uint16_t repeats;        // auto-repeats of the held direction
+  bool     leftTap;        // LEFT pressed here and not yet a long press
+  int      sortPos;        // shaker sort position and direction
+  int8_t   sortDir;
+  uint32_t sortChangedMs;
+};
+
+void listInit(ListView &list, ListCountFn count, ListRowFn row, ListKeyFn key, uint8_t sorts,
+              uint16_t *order, int capacity);
+
+// Forget all entries, e.g. for a new scan; keeps the sort
+void listReset(ListView &list);
+
+// Buttons and incremental sorting; true if the visible rows may have changed
+bool listUpdate(ListView &list);
+
+// Visible rows from baseline y (first row), with cursor marker and scrollbar
+void listDraw(const ListView &list, int y);
+
+// Backing index under the cursor, or -1 when empty
+int listSelected(const ListView &list);
+
+int listCount(const ListView &list);
+
+// Key helpers for sources
+uint32_t listNameKey(const char *name);     // first 4 chars, case folded; empty last
+uint32_t listRssiKey(int rssi);             // strongest first
+
+#endif
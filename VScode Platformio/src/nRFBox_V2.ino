@@ -6,14 +6,11 @@
    #include <Arduino.h>
    #include <U8g2lib.h>
    #include <stdint.h>
-   #include <EEPROM.h>
    #ifdef U8X8_HAVE_HW_I2C
    #include <Wire.h>
    #endif
-   #include <SPI.h>
-   #include <RF24.h>
    
-   #include "icon.h"
+   #include "icon_tiles.h"
    #include "setting.h"
    #include "SnakeGame.h"
    #include "scanner.h"
@@ -23,64 +20,58 @@
    #include "spoofer.h"
    #include "sourapple.h"
    #include "blescan.h"
+   #include "blecount.h"
+   #include "bledevices.h"
    #include "wifiscan.h"
    #include "blackout.h"
    #include "flipper.h"
    #include "wifideauth.h"
-   
-   // flipper.h does not declare its loop function—forward‐declare it here:
-   void flipperLoop();
-   
-   // ── RF24 MODULE PINS ─────────────────────────────────────────────────────────
-   #define CE_PIN_A   5
-   #define CSN_PIN_A 17
-   #define CE_PIN_B  16
-   #define CSN_PIN_B  4
-   #define CE_PIN_C  15
-   #define CSN_PIN_C  2
-   
-   RF24 RadioA(CE_PIN_A, CSN_PIN_A);
-   RF24 RadioB(CE_PIN_B, CSN_PIN_B);
-   RF24 RadioC(CE_PIN_C, CSN_PIN_C);
+   #include "scanlog.h"
+   #include "app.h"
+   #include "resources.h"
+   #include "boot.h"
+   #include "diag.h"
+   #include "cli.h"
+   #include "config.h"
+   #include "sentinel.h"
+   #include "neopixel.h"
+   #include "journal.h"
    
    // ── OLED DISPLAY ─────────────────────────────────────────────────────────────
    U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
    extern uint8_t oledBrightness;
    
    // ── MENU ICONS & ITEMS ────────────────────────────────────────────────────────
-   const unsigned char* bitmap_icons[13] = {
-     bitmap_icon_scanner,
-     bitmap_icon_analyzer,
-     bitmap_icon_jammer,
-     bitmap_icon_kill,
-     bitmap_icon_ble_jammer,
-     bitmap_icon_spoofer,
-     bitmap_icon_apple,
-     bitmap_icon_ble,
-     bitmap_icon_ble,
-     bitmap_icon_wifi,
-     bitmap_icon_wifi,
-     bitmap_icon_about,
-     bitmap_icon_setting
+   // Every menu entry is an app: enter / tick / exit hooks run by app.cpp,
+   // plus the resources (resources.h) it holds while it is on screen
+   void about();
+   
+   const App apps[] = {
+     { "Scanner",      &tile_icon_scanner,    scannerSetup,    scannerLoop,    nullptr,        RES_NRF24, APP_KEEP_AWAKE },
+     { "Analyzer",     &tile_icon_analyzer,   analyzerSetup,   analyzerLoop,   nullptr,        RES_NRF24, APP_KEEP_AWAKE },
+     { "WLAN Jammer",  &tile_icon_jammer,     jammerSetup,     jammerLoop,     jammerStop,     RES_NRF24, 0 },
+     { "Sentinel",     &tile_icon_analyzer,   sentinelSetup,   sentinelLoop,   sentinelStop,   RES_NRF24, APP_DUTY_CYCLED },
+     { "Proto Kill",   &tile_icon_kill,       blackoutSetup,   blackoutLoop,   blackoutStop,   RES_NRF24, 0 },
+     { "BLE Jammer",   &tile_icon_ble_jammer, blejammerSetup,  blejammerLoop,  blejammerStop,  RES_NRF24, 0 },
+     { "BLE Spoofer",  &tile_icon_spoofer,    spooferSetup,    spooferLoop,    spooferStop,    RES_BT,    0 },
+     { "Sour Apple",   &tile_icon_apple,      sourappleSetup,  sourappleLoop,  sourappleStop,  RES_BT,    0 },
+     { "BLE Scan",     &tile_icon_ble,        blescanSetup,    blescanLoop,    blescanStop,    RES_BT,    APP_KEEP_AWAKE },
+     { "Flipper Scan", &tile_icon_ble,        flipperSetup,    flipperLoop,    flipperStop,    RES_BT,    APP_KEEP_AWAKE },
+     { "BLE Count",    &tile_icon_stat,       blecountSetup,   blecountLoop,   blecountStop,   RES_BT,    APP_KEEP_AWAKE },
+     { "WiFi Scan",    &tile_icon_wifi,       wifiscanSetup,   wifiscanLoop,   wifiscanStop,   RES_WIFI,  0 },
+     { "WiFi Deauth",  &tile_icon_wifi,       wifiDeauthSetup, wifiDeauthLoop, wifiDeauthStop, RES_WIFI,  APP_OWNS_SELECT },
+     { "Resources",    &tile_icon_stat,       resPageSetup,    resPageLoop,    nullptr,        0,         0 },
+     { "About",        &tile_icon_about,      nullptr,         about,          nullptr,        0,         0 },
+     { "Setting",      &tile_icon_setting,    settingSetup,    settingLoop,    nullptr,        0,         0 }
    };
    
-   const int NUM_ITEMS       = 13;
-   const int MAX_ITEM_LENGTH = 20;
-   char menu_items[NUM_ITEMS][MAX_ITEM_LENGTH] = {
-     { "Scanner" },
-     { "Analyzer" },
-     { "WLAN Jammer" },
-     { "Proto Kill" },
-     { "BLE Jammer" },
-     { "BLE Spoofer" },
-     { "Sour Apple" },
-     { "BLE Scan" },
-     { "Flipper Scan" },
-     { "WiFi Scan" },
-     { "WiFi Deauth"},
-     { "About" },
-     { "Setting" }
-   };
+   const int NUM_ITEMS = sizeof(apps) / sizeof(apps[0]);
+   
+   // Hidden behind the secret code on the About screen
+   const App snakeApp = { "Snake", nullptr, setupSnakeGame, loopSnakeGame, nullptr, 0, APP_OWNS_SELECT | APP_KEEP_AWAKE };
+   
+   // Hidden, LEFT held on the menu
+   const App diagApp = { "Diagnostics", nullptr, diagPageSetup, diagPageLoop, nullptr, 0, 0 };
    
    // ── BUTTON PINS ───────────────────────────────────────────────────────────────
    #define BUTTON_UP_PIN     26
@@ -89,34 +80,16 @@
    #define BUTTON_RIGHT_PIN  27
    #define BUTTON_SELECT_PIN 32
    
-   int button_up_clicked     = 0;
-   int button_down_clicked   = 0;
-   int button_select_clicked = 0;
-   
    // ── MENU STATE ────────────────────────────────────────────────────────────────
    int item_selected     = 0;
-   int item_sel_previous = 0;
-   int item_sel_next     = 0;
-   
-   // ── SCREEN STATES ─────────────────────────────────────────────────────────────
-   enum Screen : uint8_t {
-     SCREEN_MENU = 0,
-     SCREEN_SCANNER,
-     SCREEN_ANALYZER,
-     SCREEN_WLAN_JAMMER,
-     SCREEN_PROTO_KILL,
-     SCREEN_BLE_JAMMER,
-     SCREEN_BLE_SPOOFER,
-     SCREEN_SOUR_APPLE,
-     SCREEN_BLE_SCAN,
-     SCREEN_FLIPPER_SCAN,
-     SCREEN_WIFI_SCAN,
-     SCREEN_WIFI_DEAUTH,
-     SCREEN_ABOUT,
-     SCREEN_SNAKE,
-     SCREEN_SETTING
-   };
-   Screen current_screen = SCREEN_MENU;
+   
+   // Rows slide MENU_PITCH px to the new selection, easing out over
+   // MENU_SCROLL_MS. The offset comes from the clock rather than a frame
+   // count, so the slide keeps its speed when a frame runs late.
+   #define MENU_PITCH      22
+   #define MENU_SCROLL_MS  120
+   int      scrollFrom    = 0;   // row offset in px when the slide started
+   uint32_t scrollStartMs = 0;
    
    // ── SECRET-CODE CONFIG ─────────────────────────────────────────────────────────
    const int SECRET_CODE_LENGTH = 9;
@@ -129,11 +102,9 @@
    };
    int  secretCodeIndex   = 0;
    bool secretCodeEntered = false;
-   unsigned long lastBtnMs = 0;
-   const unsigned long debounceDelay = 250;
    
    //----------------------------------------------------------------------------
-   // Debounced secret-code checker (called from ABOUT screen)
+   // Secret-code checker (called from ABOUT screen)
    //----------------------------------------------------------------------------
    void checkSecretCode() {
      int pins[5] = {
@@ -145,7 +116,7 @@
      };
      for (int i = 0; i < 5; i++) {
        int p = pins[i];
-       if (digitalRead(p) == LOW && millis() - lastBtnMs > debounceDelay) {
+       if (appPressed(p)) {
          if (secretCode[secretCodeIndex] == p) {
            if (++secretCodeIndex >= SECRET_CODE_LENGTH) {
              secretCodeEntered = true;
@@ -154,7 +125,6 @@
          } else {
            secretCodeIndex = 0;
          }
-         lastBtnMs = millis();
        }
      }
    }
@@ -163,56 +133,97 @@
    // ABOUT screen renderer + secret-code watcher
    //----------------------------------------------------------------------------
    void about() {
-     u8g2.clearBuffer();
-     u8g2.setFont(u8g2_font_6x10_tf);
-     u8g2.drawStr(12, 12, "Thnx to cifertech");
-     u8g2.drawStr(20, 22, "GitHub/jbohack");
-     u8g2.drawStr(12, 32, "GitHub/zRCrackiiN");
-     u8g2.drawStr(17, 42, "GitHub/cifertech");
-     u8g2.drawStr(17, 52, "The power of uWu");
-     u8g2.drawStr(23, 62, "compels you ;)");
-     u8g2.sendBuffer();
+     if (appRedraw()) {
+       u8g2.clearBuffer();
+       u8g2.setFont(u8g2_font_6x10_tf);
+       u8g2.drawStr(12, 12, "Thnx to cifertech");
+       u8g2.drawStr(20, 22, "GitHub/jbohack");
+       u8g2.drawStr(12, 32, "GitHub/zRCrackiiN");
+       u8g2.drawStr(17, 42, "GitHub/cifertech");
+       u8g2.drawStr(17, 52, "The power of uWu");
+       u8g2.drawStr(23, 62, "compels you ;)");
+       u8g2.sendBuffer();
+     }
    
      checkSecretCode();
      if (secretCodeEntered) {
        secretCodeEntered = false;
-       setupSnakeGame();
-       // wait for SELECT to be released so we don’t immediately exit
-       while (digitalRead(BUTTON_SELECT_PIN) == LOW) delay(10);
-       button_select_clicked = 0;
-       current_screen = SCREEN_SNAKE;
+       // the final SELECT press is consumed here, so it does not also leave About
+       appStart(snakeApp);
      }
    }
    
    //----------------------------------------------------------------------------
-   // RF24 common initialization
+   // Main menu, the home app
    //----------------------------------------------------------------------------
-   void configureNrf(RF24 &radio) {
-     radio.begin();
-     radio.setAutoAck(false);
-     radio.stopListening();
-     radio.setRetries(0, 0);
-     radio.setPALevel(RF24_PA_MAX, true);
-     radio.setDataRate(RF24_2MBPS);
-     radio.setCRCLength(RF24_CRC_DISABLED);
+   int menuScrollOffset() {
+     int32_t left = MENU_SCROLL_MS - (int32_t)(millis() - scrollStartMs);
+     if (left <= 0) return 0;
+     // quadratic ease-out, (1 - t)^2 of the distance is still to go
+     return scrollFrom * left * left / (MENU_SCROLL_MS * MENU_SCROLL_MS);
    }
    
-   //----------------------------------------------------------------------------
-   // Arduino setup()
-   //----------------------------------------------------------------------------
-   void setup() {
-     configureNrf(RadioA);
-     configureNrf(RadioB);
-     configureNrf(RadioC);
+   void menuScroll(int step) {
+     // auto-repeat can outrun the slide; stay within a row of the target
+     int from = menuScrollOffset() + step * MENU_PITCH;
+     scrollFrom = constrain(from, -MENU_PITCH, MENU_PITCH);
+     scrollStartMs = millis();
+     item_selected = (item_selected + step + NUM_ITEMS) % NUM_ITEMS;
+   }
    
-     EEPROM.begin(512);
-     oledBrightness = EEPROM.read(1);
+   void menuTick() {
+     // Navigate Up/Down
+     if (appPressedRepeat(BUTTON_UP_PIN)) menuScroll(-1);
+     if (appPressedRepeat(BUTTON_DOWN_PIN)) menuScroll(1);
    
-     u8g2.begin();
-     u8g2.setContrast(oledBrightness);
-     u8g2.setBitmapMode(1);
+     // Select
+     if (appPressed(BUTTON_SELECT_PIN)) {
+       appStart(apps[item_selected]);
+       return;
+     }
+     if (appLongPressed(BUTTON_LEFT_PIN)) {
+       appStart(diagApp);
+       return;
+     }
+   
+     // Draw menu when the selection changed, and every frame while it slides
+     if (!appRedraw()) return;
+   
+     int offset = menuScrollOffset();
+     {
+       DIAG_SCOPE("menu render");
+       u8g2.clearBuffer();
+       tileDraw(tile_item_sel_outline, 0, 22);
+   
+       // rows -2..2 cover the screen for offsets up to one row
+       for (int row = -2; row <= 2; row++) {
+         const App &app = apps[(item_selected + row + 2 * NUM_ITEMS) % NUM_ITEMS];
+         int y = row * MENU_PITCH + offset;
+         if (y <= -40 || y >= 40) continue;     // icon and text both off screen
+         u8g2.setFont(row == 0 ? u8g_font_7x14B : u8g_font_7x14);
+         u8g2.drawStr(25, 37 + y, app.name);
+         if (app.icon) tileDraw(*app.icon, 4, 24 + y);
+       }
+   
+       tileDraw(tile_scrollbar_background, 128 - 8, 0);
+       int thumb = 64 / NUM_ITEMS;
+       int thumbY = thumb * item_selected - thumb * offset / MENU_PITCH;
+       u8g2.drawBox(125, constrain(thumbY, 0, 64 - thumb), 3, thumb);
+     }
+     {
+       DIAG_SCOPE("menu send");
+       u8g2.sendBuffer();
+     }
+   
+     if (offset != 0) appInvalidate();
+   }
    
-     // Intro splash
+   const App menuApp = { "Menu", nullptr, nullptr, menuTick, nullptr, 0, 0 };
+   
+   //----------------------------------------------------------------------------
+   // Splash
+   //----------------------------------------------------------------------------
+   void drawSplash() {
      u8g2.clearBuffer();
      u8g2.setFont(u8g2_font_ncenB14_tr);
      int16_t x = (128 - u8g2.getUTF8Width("nRF-BOX")) / 2;
@@ -227,220 +238,56 @@
      u8g2.setCursor(x, 60);
      u8g2.print("v2.6.1");
      u8g2.sendBuffer();
-     delay(3000);
+   }
    
+   //----------------------------------------------------------------------------
+   // Arduino setup()
+   //----------------------------------------------------------------------------
+   void setup() {
+     Serial.begin(115200);
+     bootMark("setup");
+   
+     // What the previous run left behind, before anything can fail again
+     journalSetup();
+   
+     // The brightness is needed before the first frame
+     configSetup();
+     neopixelSetup();
+     bootMark("config");
+   
+     u8g2.begin();
+     u8g2.setContrast(oledBrightness);
+     u8g2.setBitmapMode(1);
+     drawSplash();
+     bootMark("splash");
+   
+     // The radios are probed on core 0 while the rest of the boot continues;
+     // the first nRF24 screen waits for the probe (resources.cpp)
+     bootProbeRadios();
+   
+     scanlogSetup();      // SPIFFS is mounted by the log task itself
+     bootMark("scanlog");
+   
+   #if !FAST_BOOT
+     delay(3000);
      u8g2.clearBuffer();
-     u8g2.drawXBMP(0, 0, 128, 64, logo_cifer);
+     tileDraw(tile_logo_cifer, 0, 0);
      u8g2.sendBuffer();
      delay(250);
+   #endif
    
-     // Pre-initialize Snake so it’s ready to go
-     setupSnakeGame();
+     // No driver is running yet
+     resSetup(0);
    
-     // Button inputs
-     pinMode(BUTTON_UP_PIN,     INPUT_PULLUP);
-     pinMode(BUTTON_DOWN_PIN,   INPUT_PULLUP);
-     pinMode(BUTTON_LEFT_PIN,   INPUT_PULLUP);
-     pinMode(BUTTON_RIGHT_PIN,  INPUT_PULLUP);
-     pinMode(BUTTON_SELECT_PIN, INPUT_PULLUP);
+     // Sets up the button inputs and enters the menu
+     appSetup(menuApp);
+     cliSetup(apps, NUM_ITEMS);
+     bootDone();
    }
    
    //----------------------------------------------------------------------------
-   // Main loop: MENU → [XxxSetup()/XxxLoop()] → back to MENU
+   // Main loop: one frame of the current app (see app.h)
    //----------------------------------------------------------------------------
    void loop() {
-     switch (current_screen) {
-   
-       // ─── SCREEN_MENU ─────────────────────────────────────────────────────────
-       case SCREEN_MENU: {
-         // Navigate Up/Down
-         if (digitalRead(BUTTON_UP_PIN) == LOW && !button_up_clicked) {
-           button_up_clicked = 1;
-           item_selected = (item_selected == 0) ? NUM_ITEMS - 1 : item_selected - 1;
-         }
-         if (digitalRead(BUTTON_DOWN_PIN) == LOW && !button_down_clicked) {
-           button_down_clicked = 1;
-           item_selected = (item_selected + 1) % NUM_ITEMS;
-         }
-         if (digitalRead(BUTTON_UP_PIN) == HIGH)   button_up_clicked   = 0;
-         if (digitalRead(BUTTON_DOWN_PIN) == HIGH) button_down_clicked = 0;
-   
-         // Select
-         if (digitalRead(BUTTON_SELECT_PIN) == LOW && !button_select_clicked) {
-           button_select_clicked = 1;
-           switch(item_selected) {
-             case  0: scannerSetup();     current_screen = SCREEN_SCANNER;    break;
-             case  1: analyzerSetup();    current_screen = SCREEN_ANALYZER;   break;
-             case  2: jammerSetup();      current_screen = SCREEN_WLAN_JAMMER;break;
-             case  3: blackoutSetup();    current_screen = SCREEN_PROTO_KILL; break;
-             case  4: blejammerSetup();   current_screen = SCREEN_BLE_JAMMER; break;
-             case  5: spooferSetup();     current_screen = SCREEN_BLE_SPOOFER;break;
-             case  6: sourappleSetup();   current_screen = SCREEN_SOUR_APPLE; break;
-             case  7: blescanSetup();     current_screen = SCREEN_BLE_SCAN;   break;
-             case  8: flipperSetup();     current_screen = SCREEN_FLIPPER_SCAN;break;
-             case  9: wifiscanSetup();    current_screen = SCREEN_WIFI_DEAUTH;  break;
-             case 10: wifiDeauthSetup();    current_screen = SCREEN_WIFI_SCAN;  break;
-             case 11:                      current_screen = SCREEN_ABOUT;       break;
-             case 12: settingSetup();     current_screen = SCREEN_SETTING;    break;
-           }
-           delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN) == HIGH) button_select_clicked = 0;
-   
-         // Draw menu
-         item_sel_previous = (item_selected + NUM_ITEMS - 1) % NUM_ITEMS;
-         item_sel_next     = (item_selected + 1) % NUM_ITEMS;
-   
-         u8g2.clearBuffer();
-         u8g2.drawXBMP(0,22,128,21,bitmap_item_sel_outline);
-         u8g2.setFont(u8g_font_7x14);
-         u8g2.drawStr(25,15, menu_items[item_sel_previous]);
-         u8g2.drawXBMP(4,2,16,16,bitmap_icons[item_sel_previous]);
-         u8g2.setFont(u8g_font_7x14B);
-         u8g2.drawStr(25,37, menu_items[item_selected]);
-         u8g2.drawXBMP(4,24,16,16,bitmap_icons[item_selected]);
-         u8g2.setFont(u8g_font_7x14);
-         u8g2.drawStr(25,59, menu_items[item_sel_next]);
-         u8g2.drawXBMP(4,46,16,16,bitmap_icons[item_sel_next]);
-         u8g2.drawXBMP(128 - 8,0,8,64,bitmap_scrollbar_background);
-         u8g2.drawBox(125,(64/NUM_ITEMS)*item_selected,3,64/NUM_ITEMS);
-         u8g2.sendBuffer();
-         break;
-       }
-   
-       // ─── SCREEN_SCANNER ────────────────────────────────────────────────────────
-       case SCREEN_SCANNER:
-         scannerLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_ANALYZER ───────────────────────────────────────────────────────
-       case SCREEN_ANALYZER:
-         analyzerLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_WLAN_JAMMER ────────────────────────────────────────────────────
-       case SCREEN_WLAN_JAMMER:
-         jammerLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_PROTO_KILL ─────────────────────────────────────────────────────
-       case SCREEN_PROTO_KILL:
-         blackoutLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_BLE_JAMMER ─────────────────────────────────────────────────────
-       case SCREEN_BLE_JAMMER:
-         blejammerLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_BLE_SPOOFER ────────────────────────────────────────────────────
-       case SCREEN_BLE_SPOOFER:
-         spooferLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_SOUR_APPLE ──────────────────────────────────────────────────────
-       case SCREEN_SOUR_APPLE:
-         sourappleLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_BLE_SCAN ───────────────────────────────────────────────────────
-       case SCREEN_BLE_SCAN:
-         blescanSetup();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_FLIPPER_SCAN ───────────────────────────────────────────────────
-       case SCREEN_FLIPPER_SCAN:
-         flipperSetup(); // now forward-declared above
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_WIFI_SCAN ──────────────────────────────────────────────────────
-       case SCREEN_WIFI_SCAN:
-         wifiscanLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-
-       // ─── SCREEN_WIFI_DEAUTH ──────────────────────────────────────────────────────
-       case SCREEN_WIFI_DEAUTH:
-        if (wifiDeauthLoop()) {
-          current_screen = SCREEN_MENU;
-        }
-        break;
-
-       // ─── SCREEN_ABOUT ──────────────────────────────────────────────────────────
-       case SCREEN_ABOUT:
-         about();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-   
-       // ─── SCREEN_SNAKE ──────────────────────────────────────────────────────────
-       case SCREEN_SNAKE:
-        if (loopSnakeGame()) {
-          current_screen = SCREEN_MENU;
-        }
-        break;
-   
-       // ─── SCREEN_SETTING ────────────────────────────────────────────────────────
-       case SCREEN_SETTING:
-         settingLoop();
-         if (digitalRead(BUTTON_SELECT_PIN)==LOW && !button_select_clicked) {
-           button_select_clicked=1;
-           current_screen=SCREEN_MENU; delay(200);
-         }
-         if (digitalRead(BUTTON_SELECT_PIN)==HIGH) button_select_clicked=0;
-         break;
-     }
+     appRun();
    }
-   
\ No newline at end of file
@@ -3,61 +3,164 @@
    https://github.com/cifertech/nrfbox
    ________________________________________ */
    
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
 #include "neopixel.h"
 #include "setting.h"
-#include <EEPROM.h>
 
-extern Adafruit_NeoPixel pixels;
+enum LedLayer : uint8_t { LAYER_BACKGROUND, LAYER_FLASH, LAYER_MEMORY };
 
-void neopixelSetup() {
-  EEPROM.begin(512); 
-  neoPixelActive = EEPROM.read(0);
-  
- if (neoPixelActive) {
-  pixels.begin();
-  pixels.clear();
-  //pixels.show();
-  }
+struct LedRequest {
+  uint8_t layer;
+  LedPattern pattern;
+  LedColour colour;
+  uint8_t value;          // meter level, flash count, or low memory on/off
+  uint16_t periodMs;
+};
+
+struct LedAnimation {
+  LedPattern pattern;
+  LedColour colour;
+  uint8_t level;
+  uint16_t periodMs;
+  uint32_t startMs;
+};
+
+// r, g, b on/off per palette entry, scaled by the intensity
+static const uint8_t palette[][3] = {
+  { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 1, 0 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 },
+};
+
+static Adafruit_NeoPixel pixels(1, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
+static QueueHandle_t requests = nullptr;
+static volatile uint32_t dropped = 0;
+
+// task state
+static LedAnimation background = { LED_SOLID, LED_OFF, 0, 1000, 0 };
+static LedAnimation flashing;
+static uint8_t flashCount = 0;      // blinks of the flash playing, 0 = none
+static bool lowMemory = false;
+static uint32_t shown = 0xFFFFFFFF; // colour on the pixel
+
+static bool animated(const LedAnimation &a) {
+  return a.colour != LED_OFF && (a.pattern == LED_BLINK || a.pattern == LED_PULSE);
 }
 
-void neopixelLoop();
-
-void setNeoPixelColour(const std::string& colour) {
-  uint32_t colorValue = 0; 
-
-  if (colour == "red") {
-    colorValue = pixels.Color(5, 0, 0);
-  } else if (colour == "green") {
-    colorValue = pixels.Color(0, 5, 0);
-  } else if (colour == "blue") {
-    colorValue = pixels.Color(0, 0, 5);
-  } else if (colour == "yellow") {
-    colorValue = pixels.Color(5, 5, 0);
-  } else if (colour == "purple") {
-    colorValue = pixels.Color(5, 0, 5);
-  } else if (colour == "cyan") {
-    colorValue = pixels.Color(0, 5, 5);
-  } else if (colour == "white") {
-    colorValue = pixels.Color(5, 5, 5);
-  } else if (colour == "null") {
-    colorValue = pixels.Color(0, 0, 0);
+// Colour and intensity (0..LED_MAX) of an animation at time now
+static uint32_t frameColour(const LedAnimation &a, uint32_t now) {
+  uint32_t phase = a.periodMs ? (now - a.startMs) % a.periodMs : 0;
+  LedColour colour = a.colour;
+  uint32_t level = LED_MAX;
+
+  switch (a.pattern) {
+    case LED_SOLID:
+      break;
+    case LED_BLINK:
+      if (phase >= a.periodMs / 2) level = 0;
+      break;
+    case LED_PULSE: {
+      uint32_t half = a.periodMs / 2 ? a.periodMs / 2 : 1;
+      level = (phase < half ? phase : a.periodMs - phase) * LED_MAX / half;
+      break;
+    }
+    case LED_METER:
+      colour = a.level < 34 ? LED_GREEN : a.level < 67 ? LED_YELLOW : LED_RED;
+      level = a.level ? 1 + (uint32_t)a.level * (LED_MAX - 1) / 100 : 0;
+      break;
   }
 
-  pixels.setPixelColor(0, colorValue);
-  pixels.show();
+  const uint8_t *rgb = palette[colour];
+  return Adafruit_NeoPixel::Color(rgb[0] * level, rgb[1] * level, rgb[2] * level);
 }
 
-void flash(int numberOfFlashes, const std::vector<std::string>& colors, const std::string& finalColour) {
-  if (numberOfFlashes <= 0 || colors.empty()) {
-    Serial.println("Invalid parameters for flash: Check numberOfFlashes or colors vector.");
-    return;
+static void apply(const LedRequest &r, uint32_t now) {
+  switch (r.layer) {
+    case LAYER_BACKGROUND:
+      background = { r.pattern, r.colour, r.value, r.periodMs, now };
+      break;
+    case LAYER_FLASH:
+      flashing = { LED_BLINK, r.colour, 0, r.periodMs, now };
+      flashCount = r.value;
+      break;
+    case LAYER_MEMORY:
+      lowMemory = r.value;
+      break;
   }
+}
 
-  for (int i = 0; i < numberOfFlashes; ++i) {
-    for (const auto& color : colors) {
-      setNeoPixelColour(color);
-      delay(500);
+static void ledTask(void *) {
+  static const LedAnimation warning = { LED_PULSE, LED_YELLOW, 0, 2000, 0 };
+  for (;;) {
+    uint32_t now = millis();
+    uint32_t colour;
+    if (flashCount && now - flashing.startMs >= (uint32_t)flashCount * flashing.periodMs) flashCount = 0;
+    if (!neoPixelActive) colour = 0;
+    else if (flashCount) colour = frameColour(flashing, now);
+    else if (lowMemory) colour = frameColour(warning, now);
+    else colour = frameColour(background, now);
+
+    if (colour != shown) {
+      pixels.setPixelColor(0, colour);
+      pixels.show();
+      shown = colour;
+    }
+
+    // sleep on the queue unless something is moving
+    bool moving = flashCount || lowMemory || animated(background);
+    LedRequest r;
+    if (xQueueReceive(requests, &r, moving ? pdMS_TO_TICKS(LED_STEP_MS) : portMAX_DELAY) == pdTRUE) {
+      do {
+        apply(r, millis());
+      } while (xQueueReceive(requests, &r, 0) == pdTRUE);
     }
   }
-  setNeoPixelColour(finalColour);
+}
+
+// neoPixelActive is loaded at boot (config.h)
+void neopixelSetup() {
+  if (!neoPixelActive) return;
+  pixels.begin();
+  pixels.clear();
+  pixels.show();
+  requests = xQueueCreate(LED_QUEUE_DEPTH, sizeof(LedRequest));
+  xTaskCreatePinnedToCore(ledTask, "led", 2048, nullptr, 1, nullptr, 0);
+}
+
+static void post(uint8_t layer, LedPattern pattern, LedColour colour, uint8_t value, uint16_t periodMs) {
+  if (!requests) return;
+  LedRequest r = { layer, pattern, colour, value, periodMs };
+  if (xQueueSend(requests, &r, 0) != pdTRUE) dropped++;
+}
+
+void ledSet(LedPattern pattern, LedColour colour, uint16_t periodMs) {
+  post(LAYER_BACKGROUND, pattern, colour, 0, periodMs);
+}
+
+void ledLevel(uint8_t percent) {
+  post(LAYER_BACKGROUND, LED_METER, LED_GREEN, percent > 100 ? 100 : percent, 0);
+}
+
+void ledClear() {
+  post(LAYER_BACKGROUND, LED_SOLID, LED_OFF, 0, 0);
+}
+
+void ledFlash(LedColour colour, uint8_t count, uint16_t periodMs) {
+  post(LAYER_FLASH, LED_BLINK, colour, count, periodMs);
+}
+
+void ledStatus(LedStatus status) {
+  switch (status) {
+    case LED_NEW_DEVICE: ledFlash(LED_CYAN, 2, 120); break;
+    case LED_TRIGGER:    ledFlash(LED_RED, 3, 250); break;
+    case LED_LOW_MEMORY: post(LAYER_MEMORY, LED_PULSE, LED_YELLOW, 1, 0); break;
+    case LED_MEMORY_OK:  post(LAYER_MEMORY, LED_PULSE, LED_YELLOW, 0, 0); break;
+  }
+}
+
+uint32_t ledDropped() {
+  return dropped;
 }
@@ -5,16 +5,58 @@
 #ifndef NEOPIXEL_H
 #define NEOPIXEL_H
 
-#include <Adafruit_NeoPixel.h>
-#include <vector>
-#include <string>
+#include <stdint.h>
 
-extern Adafruit_NeoPixel pixels;
+// Status LED engine.
+//
+// The LED is driven by its own task on core 0, which runs the animations
+// (blink, pulse, level meter) in 20 ms steps and only talks to the pixel
+// when its colour actually changes. Screens and callbacks post requests
+// through a queue and never wait: a full queue drops the request and counts
+// it. With nothing animating the task sleeps on the queue.
+//
+// Two layers: the background belongs to the running screen (cleared on
+// every screen switch by the app runtime) and shows while no flash plays;
+// a flash blinks a colour a few times over it and then hands back. A low
+// memory warning replaces the background until the heap recovers.
+//
+// The engine only starts when the "neopixel" setting is on at boot.
+
+#define NEOPIXEL_PIN    14
+#define LED_MAX         8       // channel value at full intensity; the LED sits next to the OLED
+#define LED_STEP_MS     20
+#define LED_QUEUE_DEPTH 8
+
+enum LedColour : uint8_t {
+  LED_OFF, LED_RED, LED_GREEN, LED_BLUE, LED_YELLOW, LED_PURPLE, LED_CYAN, LED_WHITE
+};
+
+enum LedPattern : uint8_t {
+  LED_SOLID,
+  LED_BLINK,      // on for half the period
+  LED_PULSE,      // fades up and down once per period
+  LED_METER,      // level 0..100 as colour (green, yellow, red) and intensity
+};
+
+enum LedStatus : uint8_t {
+  LED_NEW_DEVICE,   // short cyan double flash
+  LED_TRIGGER,      // red triple flash (sentinel alert)
+  LED_LOW_MEMORY,   // yellow pulse instead of the background
+  LED_MEMORY_OK,
+};
 
 void neopixelSetup();
-void neopixelLoop();
 
-void setNeoPixelColour(const std::string& colour);
-void flash(int numberOfFlashes, const std::vector<std::string>& colors, const std::string& finalColour);
+// Background of the current screen
+void ledSet(LedPattern pattern, LedColour colour, uint16_t periodMs = 1000);
+void ledLevel(uint8_t percent);     // LED_METER, e.g. scanner activity
+void ledClear();
+
+// Plays over the background: count blinks of periodMs each
+void ledFlash(LedColour colour, uint8_t count, uint16_t periodMs = 200);
+
+void ledStatus(LedStatus status);
+
+uint32_t ledDropped();
 
 #endif // NEOPIXEL_H
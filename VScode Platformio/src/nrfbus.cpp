@@ -0,0 +1,262 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nrfbus.h"
+
+// VSPI's own IO_MUX pins, so the clock does not go through the GPIO matrix
+#define NRF_SCK   18
+#define NRF_MISO  19
+#define NRF_MOSI  23
+
+static const uint8_t csnPins[NRF_RADIOS] = { 17, 4, 2 };
+
+static spi_device_handle_t devices[NRF_RADIOS];
+static uint32_t clockHz[NRF_RADIOS] = { NRF_BUS_DEFAULT_HZ, NRF_BUS_DEFAULT_HZ, NRF_BUS_DEFAULT_HZ };
+enum BusMode : uint8_t { BUS_CLOSED, BUS_SPI_MASTER, BUS_ARDUINO };
+static BusMode mode = BUS_CLOSED;
+static int heldBy = -1;           // radio holding the bus through nrfBusAcquire()
+static TaskHandle_t heldTask = nullptr;
+
+static uint32_t polled[NRF_RADIOS];
+static uint32_t batches[NRF_RADIOS];
+static uint32_t batched[NRF_RADIOS];    // transactions run in batches
+static uint32_t errors = 0;
+
+static bool addDevice(int radio) {
+  spi_device_interface_config_t config;
+  memset(&config, 0, sizeof(config));
+  config.mode = 0;
+  config.clock_speed_hz = clockHz[radio];
+  config.spics_io_num = csnPins[radio];
+  config.queue_size = NRF_BATCH_MAX;
+  if (spi_bus_add_device(SPI3_HOST, &config, &devices[radio]) == ESP_OK) return true;
+  devices[radio] = nullptr;
+  errors++;
+  return false;
+}
+
+static void removeDevices() {
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    if (devices[i]) spi_bus_remove_device(devices[i]);
+    devices[i] = nullptr;
+  }
+}
+
+// spi_master refused the bus: the Arduino driver with CSN by hand
+static bool beginFallback() {
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    pinMode(csnPins[i], OUTPUT);
+    digitalWrite(csnPins[i], HIGH);
+  }
+  SPI.begin();
+  errors++;
+  mode = BUS_ARDUINO;
+  Serial.println("nrfbus: spi_master refused VSPI, using SPI.transfer() instead");
+  return false;
+}
+
+bool nrfBusBegin() {
+  if (mode == BUS_SPI_MASTER) return true;
+  if (mode == BUS_ARDUINO) return false;
+  SPI.end();
+
+  spi_bus_config_t bus;
+  memset(&bus, 0, sizeof(bus));
+  bus.sclk_io_num = NRF_SCK;
+  bus.miso_io_num = NRF_MISO;
+  bus.mosi_io_num = NRF_MOSI;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+
+  // two-byte transactions fit the FIFO, DMA would only add set-up time
+  if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_DISABLED) != ESP_OK) return beginFallback();
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    if (!addDevice(i)) {
+      removeDevices();
+      spi_bus_free(SPI3_HOST);
+      return beginFallback();
+    }
+  }
+  mode = BUS_SPI_MASTER;
+  return true;
+}
+
+void nrfBusEnd() {
+  if (mode == BUS_ARDUINO) mode = BUS_CLOSED;     // SPI is already the Arduino driver's
+  if (mode != BUS_SPI_MASTER) return;
+  if (heldBy >= 0) nrfBusRelease((NrfRadio)heldBy);
+  removeDevices();
+  spi_bus_free(SPI3_HOST);
+  mode = BUS_CLOSED;
+
+  // CSN back to plain outputs, idle high, for the SPI.transfer() users
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    pinMode(csnPins[i], OUTPUT);
+    digitalWrite(csnPins[i], HIGH);
+  }
+  SPI.begin();
+}
+
+bool nrfBusActive() {
+  return mode != BUS_CLOSED;
+}
+
+void nrfBusClock(NrfRadio radio, uint32_t hz) {
+  if (radio >= NRF_RADIOS || hz == clockHz[radio]) return;
+  clockHz[radio] = hz;
+  if (mode != BUS_SPI_MASTER) return;
+  if (heldBy == radio) nrfBusRelease(radio);
+  if (devices[radio]) spi_bus_remove_device(devices[radio]);
+  addDevice(radio);
+}
+
+uint32_t nrfBusClockHz(NrfRadio radio) {
+  return radio < NRF_RADIOS ? clockHz[radio] : 0;
+}
+
+// Another radio held by this same task: spi_master would wait for it forever
+static bool heldBySelf(NrfRadio radio) {
+  if (heldBy < 0 || heldBy == radio || heldTask != xTaskGetCurrentTaskHandle()) return false;
+  errors++;
+  return true;
+}
+
+void nrfBusAcquire(NrfRadio radio) {
+  if (mode != BUS_SPI_MASTER || radio >= NRF_RADIOS || !devices[radio] || heldBy == radio) return;
+  if (heldBySelf(radio)) return;
+  if (spi_device_acquire_bus(devices[radio], portMAX_DELAY) == ESP_OK) {
+    heldBy = radio;
+    heldTask = xTaskGetCurrentTaskHandle();
+  } else {
+    errors++;
+  }
+}
+
+void nrfBusRelease(NrfRadio radio) {
+  if (heldBy != radio) return;
+  spi_device_release_bus(devices[radio]);
+  heldBy = -1;
+  heldTask = nullptr;
+}
+
+static void setTransaction(spi_transaction_t &t, uint8_t command, uint8_t value) {
+  memset(&t, 0, sizeof(t));
+  t.flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+  t.length = 16;
+  t.tx_data[0] = command;
+  t.tx_data[1] = value;
+}
+
+static uint8_t fallbackTransfer(NrfRadio radio, uint8_t command, uint8_t value) {
+  SPI.beginTransaction(SPISettings(clockHz[radio], MSBFIRST, SPI_MODE0));
+  digitalWrite(csnPins[radio], LOW);
+  SPI.transfer(command);
+  uint8_t result = SPI.transfer(value);
+  digitalWrite(csnPins[radio], HIGH);
+  SPI.endTransaction();
+  return result;
+}
+
+static uint8_t transfer(NrfRadio radio, uint8_t command, uint8_t value) {
+  if (radio >= NRF_RADIOS) return 0;
+  if (mode == BUS_ARDUINO) {
+    polled[radio]++;
+    return fallbackTransfer(radio, command, value);
+  }
+  if (mode != BUS_SPI_MASTER || !devices[radio] || heldBySelf(radio)) return 0;
+  spi_transaction_t t;
+  setTransaction(t, command, value);
+  if (spi_device_polling_transmit(devices[radio], &t) != ESP_OK) {
+    errors++;
+    return 0;
+  }
+  polled[radio]++;
+  return t.rx_data[1];
+}
+
+uint8_t nrfRead(NrfRadio radio, uint8_t reg) {
+  return transfer(radio, NRF_R_REGISTER | (reg & 0x1F), NRF_NOP);
+}
+
+void nrfWrite(NrfRadio radio, uint8_t reg, uint8_t value) {
+  transfer(radio, NRF_W_REGISTER | (reg & 0x1F), value);
+}
+
+void nrfBatchClear(NrfBatch &batch) {
+  batch.count = 0;
+}
+
+static int batchAdd(NrfBatch &batch, uint8_t command, uint8_t value) {
+  if (batch.count >= NRF_BATCH_MAX) return -1;
+  setTransaction(batch.trans[batch.count], command, value);
+  return batch.count++;
+}
+
+int nrfBatchRead(NrfBatch &batch, uint8_t reg) {
+  return batchAdd(batch, NRF_R_REGISTER | (reg & 0x1F), NRF_NOP);
+}
+
+int nrfBatchWrite(NrfBatch &batch, uint8_t reg, uint8_t value) {
+  return batchAdd(batch, NRF_W_REGISTER | (reg & 0x1F), value);
+}
+
+bool nrfBatchRun(NrfRadio radio, NrfBatch &batch) {
+  if (radio >= NRF_RADIOS) return false;
+  if (mode == BUS_ARDUINO) {
+    for (int i = 0; i < batch.count; i++) {
+      spi_transaction_t &t = batch.trans[i];
+      t.rx_data[1] = fallbackTransfer(radio, t.tx_data[0], t.tx_data[1]);
+    }
+    batches[radio]++;
+    batched[radio] += batch.count;
+    return true;
+  }
+  if (mode != BUS_SPI_MASTER || !devices[radio] || heldBySelf(radio)) return false;
+  spi_device_handle_t device = devices[radio];
+
+  // held for the whole sequence so another radio cannot slip in between
+  bool acquired = heldBy != radio;
+  if (acquired && spi_device_acquire_bus(device, portMAX_DELAY) != ESP_OK) {
+    errors++;
+    return false;
+  }
+
+  bool ok = true;
+  int queued = 0;
+  for (; queued < batch.count; queued++) {
+    if (spi_device_queue_trans(device, &batch.trans[queued], portMAX_DELAY) != ESP_OK) {
+      ok = false;
+      break;
+    }
+  }
+  for (int i = 0; i < queued; i++) {
+    spi_transaction_t *done;
+    if (spi_device_get_trans_result(device, &done, portMAX_DELAY) != ESP_OK) ok = false;
+  }
+  if (acquired) spi_device_release_bus(device);
+
+  batches[radio]++;
+  batched[radio] += queued;
+  if (!ok) errors++;
+  return ok;
+}
+
+uint8_t nrfBatchResult(const NrfBatch &batch, int slot) {
+  return slot >= 0 && slot < batch.count ? batch.trans[slot].rx_data[1] : 0;
+}
+
+void nrfBusDump() {
+  static const char *const modeNames[] = { "closed", "open", "open on the SPI.transfer() fallback" };
+  Serial.printf("nrfbus %s, %u errors\n", modeNames[mode], (unsigned)errors);
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    Serial.printf("nrfbus radio %c csn %2u %5u kHz: %u polled, %u batches (%u transactions)%s\n",
+                  'A' + i, csnPins[i], (unsigned)(clockHz[i] / 1000), (unsigned)polled[i],
+                  (unsigned)batches[i], (unsigned)batched[i], heldBy == i ? ", holds the bus" : "");
+  }
+}
@@ -0,0 +1,78 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef nrfbus_H
+#define nrfbus_H
+
+// Register access to the three nRF24 modules through ESP-IDF's spi_master
+// driver, for the screens that drive a radio register by register (scanner,
+// analyzer, sentinel). Each module has its own device handle with its own
+// clock and a hardware CSN, so a register access is one 16-bit transaction
+// instead of two SPI.transfer() calls between digitalWrite()s.
+//
+// nrfBusBegin() takes VSPI from the Arduino SPI driver and app.cpp hands it
+// back on every screen switch, since the RF24 library screens still go
+// through SPI; resources.cpp opens it again to power the radios down.
+// spi_master serialises the devices, so sweepers in different tasks can share
+// the bus; nrfBusAcquire() holds it for one radio across a burst, which also
+// takes the lock out of each polled transaction.
+//
+// Should spi_master refuse the bus, the same calls fall back to
+// SPI.transfer() with CSN toggled by hand at each radio's clock, as the
+// screens did before, so a sweep still sees the radio.
+
+#include <stdint.h>
+#include "driver/spi_master.h"
+
+enum NrfRadio : uint8_t { NRF_RADIO_A, NRF_RADIO_B, NRF_RADIO_C, NRF_RADIOS };
+
+#define NRF_BUS_DEFAULT_HZ  8000000
+#define NRF_BATCH_MAX       8         // transactions per batch, also the device queue depth
+
+#define NRF_R_REGISTER      0x00
+#define NRF_W_REGISTER      0x20
+#define NRF_NOP             0xFF
+
+// A register sequence queued in one go. It runs back to back with the bus
+// held for the radio, and the bytes read are collected afterwards.
+struct NrfBatch {
+  spi_transaction_t trans[NRF_BATCH_MAX];
+  uint8_t count;
+};
+
+// Opens a device for each radio at its remembered clock. False when
+// spi_master refuses and the bus runs on the Arduino fallback instead.
+bool nrfBusBegin();
+void nrfBusEnd();       // back to the Arduino driver; nothing when not open
+bool nrfBusActive();    // open, on either driver
+
+// Kept across screens; reopens the radio's device when the bus is open
+void nrfBusClock(NrfRadio radio, uint32_t hz);
+uint32_t nrfBusClockHz(NrfRadio radio);
+
+// One radio at a time. Other tasks wait for the release. The holding task
+// itself must release before it touches another radio: those accesses (and
+// a second acquire) fail at once and count as errors, since waiting on its
+// own hold would never end.
+void nrfBusAcquire(NrfRadio radio);
+void nrfBusRelease(NrfRadio radio);
+
+// Polled: busy-waits for the one transaction, the quickest for a single
+// register. Reads return 0 while the bus is not open, or when the rule
+// above refuses them.
+uint8_t nrfRead(NrfRadio radio, uint8_t reg);
+void nrfWrite(NrfRadio radio, uint8_t reg, uint8_t value);
+
+void nrfBatchClear(NrfBatch &batch);
+// The transaction's slot for nrfBatchResult(), -1 when the batch is full
+int nrfBatchRead(NrfBatch &batch, uint8_t reg);
+int nrfBatchWrite(NrfBatch &batch, uint8_t reg, uint8_t value);
+bool nrfBatchRun(NrfRadio radio, NrfBatch &batch);
+uint8_t nrfBatchResult(const NrfBatch &batch, int slot);
+
+// Clocks and transaction counts per radio
+void nrfBusDump();
+
+#endif
@@ -0,0 +1,144 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "power.h"
+#include "resources.h"
+#include "input.h"
+#include "setting.h"
+#include "cli.h"
+#include "app.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+enum OledState : uint8_t { OLED_ON, OLED_DIM, OLED_OFF };
+
+static const char *const counterNames[PWR_COUNTERS] = {
+  "cpu full", "cpu idle", "light sleep", "oled on", "oled dim", "oled off", "nrf24", "wifi", "bt"
+};
+
+uint16_t powerDimSec = 30;
+uint16_t powerOffSec = 60;
+
+static uint64_t counterUs[PWR_COUNTERS];
+static int64_t lastFrameUs = 0;
+static uint32_t lastInputMs = 0;
+static OledState oled = OLED_ON;
+static bool cpuIdle = false;
+static bool sleepAllowed = false;
+static bool busy = false;
+
+static void setOled(OledState state) {
+  if (state == oled) return;
+  if (state == OLED_OFF) {
+    u8g2.setPowerSave(1);
+  } else {
+    if (oled == OLED_OFF) u8g2.setPowerSave(0);
+    u8g2.setContrast(state == OLED_DIM ? POWER_DIM_CONTRAST : oledBrightness);
+  }
+  oled = state;
+}
+
+static void setCpuIdle(bool idle) {
+  if (idle == cpuIdle) return;
+  setCpuFrequencyMhz(idle ? POWER_IDLE_MHZ : POWER_FULL_MHZ);
+  cpuIdle = idle;
+}
+
+void powerSetup() {
+  memset(counterUs, 0, sizeof(counterUs));
+  lastFrameUs = esp_timer_get_time();
+  lastInputMs = millis();
+}
+
+bool powerUserActivity() {
+  lastInputMs = millis();
+  setCpuIdle(false);
+  if (oled == OLED_ON) return false;
+  // the display was dimmed or off: this press only wakes it
+  setOled(OLED_ON);
+  return true;
+}
+
+void powerFrame(uint8_t heldResources, uint8_t appFlags) {
+  int64_t now = esp_timer_get_time();
+  uint64_t dt = now - lastFrameUs;
+  lastFrameUs = now;
+
+  counterUs[cpuIdle ? PWR_CPU_IDLE : PWR_CPU_FULL] += dt;
+  counterUs[oled == OLED_ON ? PWR_OLED_ON : oled == OLED_DIM ? PWR_OLED_DIM : PWR_OLED_OFF] += dt;
+  if (heldResources & RES_NRF24) counterUs[PWR_NRF24] += dt;
+  if (heldResources & RES_WIFI) counterUs[PWR_WIFI] += dt;
+  if (heldResources & RES_BT) counterUs[PWR_BT] += dt;
+
+  uint32_t idleMs = millis() - lastInputMs;
+  if (appFlags & APP_KEEP_AWAKE) {
+    setOled(OLED_ON);
+  } else if (powerOffSec && idleMs >= powerOffSec * 1000UL) {
+    setOled(OLED_OFF);
+  } else if (powerDimSec && idleMs >= powerDimSec * 1000UL) {
+    setOled(OLED_DIM);
+  }
+
+  uint8_t radios = heldResources & (RES_NRF24 | RES_WIFI | RES_BT);
+  if (appFlags & APP_DUTY_CYCLED) radios &= ~RES_NRF24;
+
+  setCpuIdle(idleMs >= POWER_IDLE_MS && !(radios & RES_NRF24));
+
+  // radios and the console need the CPU awake between frames
+  sleepAllowed = oled == OLED_OFF && !radios && !busy && !cliStreaming();
+  busy = false;
+}
+
+void powerBusy() {
+  busy = true;
+}
+
+bool powerDisplayOff() {
+  return oled == OLED_OFF;
+}
+
+void powerWait(uint32_t ms) {
+  if (!sleepAllowed) {
+    vTaskDelay(ms > portTICK_PERIOD_MS ? pdMS_TO_TICKS(ms) : 1);
+    return;
+  }
+
+  if (!inputSleepPrepare()) {
+    vTaskDelay(ms > portTICK_PERIOD_MS ? pdMS_TO_TICKS(ms) : 1);
+    return;
+  }
+  Serial.flush();
+  esp_sleep_enable_timer_wakeup(POWER_SLEEP_MAX_MS * 1000ULL);
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_uart_wakeup(0);     // the first console bytes wake it and are lost
+
+  int64_t start = esp_timer_get_time();
+  esp_light_sleep_start();
+  counterUs[PWR_LIGHT_SLEEP] += esp_timer_get_time() - start;
+
+  inputSleepResume();
+}
+
+uint32_t powerTimeMs(PowerCounter counter) {
+  return counterUs[counter] / 1000;
+}
+
+void powerReset() {
+  memset(counterUs, 0, sizeof(counterUs));
+}
+
+void powerDump() {
+  uint64_t total = counterUs[PWR_CPU_FULL] + counterUs[PWR_CPU_IDLE];
+  for (int i = 0; i < PWR_COUNTERS; i++) {
+    Serial.printf("power %-12s %9u ms %3u%%\n", counterNames[i], (unsigned)(counterUs[i] / 1000),
+                  total ? (unsigned)(counterUs[i] * 100 / total) : 0);
+  }
+  Serial.printf("power cpu %u MHz, oled %s\n", getCpuFrequencyMhz(),
+                oled == OLED_ON ? "on" : oled == OLED_DIM ? "dim" : "off");
+}
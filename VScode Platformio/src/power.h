@@ -0,0 +1,70 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef power_H
+#define power_H
+
+#include <stdint.h>
+
+// Power manager, driven by the app runtime once per frame.
+//
+//  - The nRF24 modules, WiFi and BT are powered down whenever the screen does
+//    not hold them (resources.h); this module only accounts for their time.
+//  - With no input for POWER_IDLE_MS on a screen without the nRF24 bus, the
+//    CPU drops to POWER_IDLE_MHZ. nRF24 screens keep full speed so their
+//    sweep timing does not change.
+//  - The OLED is dimmed after powerDimSec and switched off after powerOffSec
+//    without input. The press that wakes it is swallowed. Screens flagged
+//    APP_KEEP_AWAKE (live graphs) are never dimmed.
+//  - With the OLED off, no radio held and no console stream, the frame wait
+//    becomes a light sleep woken by any button, the console UART or a timer.
+//    Screens flagged APP_DUTY_CYCLED keep their nRF24 modules powered down
+//    between bursts of work and do not count as holding them.
+
+#define POWER_IDLE_MS        5000
+#define POWER_IDLE_MHZ       80      // lowest clock that keeps APB at 80 MHz
+#define POWER_FULL_MHZ       240
+#define POWER_DIM_CONTRAST   1
+#define POWER_SLEEP_MAX_MS   1000    // background tasks run at least this often
+
+enum PowerCounter : uint8_t {
+  PWR_CPU_FULL,
+  PWR_CPU_IDLE,
+  PWR_LIGHT_SLEEP,
+  PWR_OLED_ON,
+  PWR_OLED_DIM,
+  PWR_OLED_OFF,
+  PWR_NRF24,
+  PWR_WIFI,
+  PWR_BT,
+  PWR_COUNTERS
+};
+
+// Timeouts in seconds, 0 = never; set from the console
+extern uint16_t powerDimSec;
+extern uint16_t powerOffSec;
+
+void powerSetup();
+
+// A button event; true if it only woke the display and must be ignored
+bool powerUserActivity();
+
+// Once per frame, after the tick, with the running app's RES_* and APP_* sets
+void powerFrame(uint8_t heldResources, uint8_t appFlags);
+
+// Called from a tick whose work continues next frame: no sleep after it
+void powerBusy();
+
+// Screens skip their redraws while it is off (app.cpp) and catch up on wakeup
+bool powerDisplayOff();
+
+// Waits out the rest of the frame, in light sleep when allowed
+void powerWait(uint32_t ms);
+
+uint32_t powerTimeMs(PowerCounter counter);
+void powerReset();
+void powerDump();
+
+#endif
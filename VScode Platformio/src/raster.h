@@ -0,0 +1,90 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef raster_H
+#define raster_H
+
+// Column kernels for the spectrum screens that write straight into u8g2's
+// full frame buffer (getBufferPtr()).
+//
+// The SSD1306 buffer is 8 pages of 128 bytes, one byte a vertical strip of 8
+// pixels with the LSB on top. A vertical run of rows is then a start mask, a
+// few whole 0xFF bytes and an end mask, taken from the tables below, instead
+// of drawVLine()'s clip and per-pixel path.
+//
+// The bar style is a template parameter so each kernel compiles to its own
+// straight-line loop: Style::bits(x, page, mask) returns the pixels to set
+// out of `mask`, and Style::peakOnly keeps just the top row of the run.
+// Drawing ORs into the buffer; nothing is cleared.
+
+#include <stdint.h>
+
+#define RASTER_WIDTH  128
+#define RASTER_HEIGHT 64
+
+// Rows from n to the bottom of a page, and rows from the top of a page to n
+static const uint8_t rasterFromRow[8] = { 0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80 };
+static const uint8_t rasterToRow[8]   = { 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF };
+
+struct RasterSolid {
+  static const bool peakOnly = false;
+  static inline uint8_t bits(int, int, uint8_t mask) { return mask; }
+};
+
+// Only the top row of each bar, for peak-hold markers
+struct RasterPeak {
+  static const bool peakOnly = true;
+  static inline uint8_t bits(int, int, uint8_t mask) { return mask; }
+};
+
+// Ordered dither: Even on even columns, Odd on odd ones, e.g. 0x55/0xAA for
+// a 50% checkerboard or 0x11/0x44 for 25%
+template <uint8_t Even, uint8_t Odd>
+struct RasterDither {
+  static const bool peakOnly = false;
+  static inline uint8_t bits(int x, int, uint8_t mask) { return mask & ((x & 1) ? Odd : Even); }
+};
+
+typedef RasterDither<0x55, 0xAA> RasterHalftone;
+
+// Rows [top, bottom) of column x, clipped to the buffer
+template <class Style>
+static inline void rasterColumn(uint8_t *buffer, int x, int top, int bottom) {
+  if (x < 0 || x >= RASTER_WIDTH) return;
+  if (top < 0) top = 0;
+  if (bottom > RASTER_HEIGHT) bottom = RASTER_HEIGHT;
+  if (top >= bottom) return;
+  if (Style::peakOnly) bottom = top + 1;
+
+  int page = top >> 3;
+  int last = (bottom - 1) >> 3;
+  uint8_t *dst = buffer + page * RASTER_WIDTH + x;
+  if (page == last) {
+    *dst |= Style::bits(x, page, rasterFromRow[top & 7] & rasterToRow[(bottom - 1) & 7]);
+    return;
+  }
+  *dst |= Style::bits(x, page, rasterFromRow[top & 7]);
+  for (page++, dst += RASTER_WIDTH; page < last; page++, dst += RASTER_WIDTH) {
+    *dst |= Style::bits(x, page, 0xFF);
+  }
+  *dst |= Style::bits(x, page, rasterToRow[(bottom - 1) & 7]);
+}
+
+// Columns [x0, x1) of row y
+static inline void rasterHLine(uint8_t *buffer, int x0, int x1, int y) {
+  if (y < 0 || y >= RASTER_HEIGHT) return;
+  if (x0 < 0) x0 = 0;
+  if (x1 > RASTER_WIDTH) x1 = RASTER_WIDTH;
+  uint8_t bit = 1 << (y & 7);
+  uint8_t *dst = buffer + (y >> 3) * RASTER_WIDTH;
+  for (int x = x0; x < x1; x++) dst[x] |= bit;
+}
+
+static inline void rasterPixel(uint8_t *buffer, int x, int y) {
+  if (x < 0 || x >= RASTER_WIDTH || y < 0 || y >= RASTER_HEIGHT) return;
+  buffer[(y >> 3) * RASTER_WIDTH + x] |= 1 << (y & 7);
+}
+
+#endif
@@ -0,0 +1,182 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <WiFi.h>
+#include <BLEDevice.h>
+#include <U8g2lib.h>
+#include "esp_heap_caps.h"
+#include "resources.h"
+#include "app.h"
+#include "boot.h"
+#include "nrfbus.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define BUTTON_PIN_UP    26
+#define BUTTON_PIN_DOWN  33
+
+#define NRF24_CONFIG     0x00
+#define NRF24_RF_SETUP   0x06
+
+// CE / CSN of the three modules
+static const uint8_t nrfPins[3][2] = { { 5, 17 }, { 16, 4 }, { 15, 2 } };
+
+static uint8_t held = 0;
+
+static ResTransition history[RES_HISTORY];
+static int historyHead = 0;     // next slot to write
+static int historyCount = 0;
+
+static int pageScroll = 0;
+
+static void nrfAcquire() {
+  bootWaitRadios();     // the boot probe owns the bus until it is done
+  SPI.begin();
+  for (int i = 0; i < 3; i++) {
+    pinMode(nrfPins[i][0], OUTPUT);
+    pinMode(nrfPins[i][1], OUTPUT);
+    digitalWrite(nrfPins[i][0], LOW);
+    digitalWrite(nrfPins[i][1], HIGH);
+  }
+}
+
+// Drops every module back to power-down with carrier and PA settings at
+// their reset values, whatever the last screen left running. Goes through
+// nrfbus like the sweepers, so it works whichever driver holds VSPI.
+static void nrfRelease() {
+  nrfBusBegin();
+  NrfBatch batch;
+  for (int i = 0; i < NRF_RADIOS; i++) {
+    digitalWrite(nrfPins[i][0], LOW);
+    nrfBatchClear(batch);
+    nrfBatchWrite(batch, NRF24_RF_SETUP, 0x0F);
+    nrfBatchWrite(batch, NRF24_CONFIG, 0x08);
+    nrfBatchRun((NrfRadio)i, batch);
+  }
+  nrfBusEnd();
+  SPI.end();
+}
+
+void resSetup(uint8_t initial) {
+  held = initial;
+}
+
+uint8_t resHeld() {
+  return held;
+}
+
+uint32_t resRelease(uint8_t keep) {
+  uint32_t start = micros();
+  uint8_t drop = held & ~keep;
+
+  if (drop & RES_NRF24) nrfRelease();
+  if (drop & RES_WIFI) WiFi.mode(WIFI_OFF);       // stops and deinits the driver
+  if (drop & RES_BT) BLEDevice::deinit(false);    // keeps the controller memory for the next init
+
+  held &= keep;
+  return micros() - start;
+}
+
+uint32_t resAcquire(uint8_t need) {
+  uint32_t start = micros();
+  uint8_t add = need & ~held;
+
+  if (add & RES_NRF24) nrfAcquire();
+  if (add & RES_WIFI) WiFi.mode(WIFI_STA);
+  // RES_BT: BLEDevice::init() takes the advertised name, so the app calls it
+
+  held |= need;
+  return micros() - start;
+}
+
+uint32_t resFreeHeap() {
+  return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+uint32_t resLargestBlock() {
+  return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+static void formatHeld(uint8_t mask, char *out) {
+  out[0] = (mask & RES_NRF24) ? 'R' : '-';
+  out[1] = (mask & RES_WIFI)  ? 'W' : '-';
+  out[2] = (mask & RES_BT)    ? 'B' : '-';
+  out[3] = '\0';
+}
+
+static void printTransition(const ResTransition &t) {
+  char res[4];
+  formatHeld(t.held, res);
+  Serial.printf("res %-12s [%s] free %6u -> %6u (%+6d) largest %6u  release %5u us  acquire %5u us  enter %7u us\n",
+                t.app, res, (unsigned)t.freeBefore, (unsigned)t.freeAfter,
+                (int)(t.freeAfter - t.freeBefore), (unsigned)t.largestAfter,
+                (unsigned)t.releaseUs, (unsigned)t.acquireUs, (unsigned)t.enterUs);
+}
+
+void resRecord(const ResTransition &t) {
+  history[historyHead] = t;
+  historyHead = (historyHead + 1) % RES_HISTORY;
+  if (historyCount < RES_HISTORY) historyCount++;
+  printTransition(t);
+}
+
+int resHistoryCount() {
+  return historyCount;
+}
+
+const ResTransition &resHistory(int index) {
+  return history[(historyHead - 1 - index + 2 * RES_HISTORY) % RES_HISTORY];
+}
+
+void resDump() {
+  Serial.printf("res heap free %u, largest block %u, minimum ever %u\n",
+                (unsigned)resFreeHeap(), (unsigned)resLargestBlock(),
+                (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+  for (int i = historyCount - 1; i >= 0; i--) printTransition(resHistory(i));
+}
+
+void resPageSetup() {
+  pageScroll = 0;
+  resDump();
+}
+
+void resPageLoop() {
+  const int rows = 4;
+  int maxScroll = historyCount > rows ? historyCount - rows : 0;
+  if (appPressedRepeat(BUTTON_PIN_UP) && pageScroll > 0) pageScroll--;
+  if (appPressedRepeat(BUTTON_PIN_DOWN) && pageScroll < maxScroll) pageScroll++;
+
+  // heap figures refresh once a second
+  if (!appRedraw()) return;
+  appInvalidateIn(1000);
+
+  char line[32];
+  char res[4];
+
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_5x8_tr);
+
+  formatHeld(resHeld(), res);
+  snprintf(line, sizeof(line), "Resources      [%s]", res);
+  u8g2.drawStr(0, 8, line);
+  snprintf(line, sizeof(line), "free %u big %u", (unsigned)resFreeHeap(), (unsigned)resLargestBlock());
+  u8g2.drawStr(0, 17, line);
+  snprintf(line, sizeof(line), "min  %u", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+  u8g2.drawStr(0, 26, line);
+  u8g2.drawHLine(0, 29, 128);
+
+  // newest first: app, heap change across the switch, total switch time
+  for (int i = 0; i < rows && pageScroll + i < historyCount; i++) {
+    const ResTransition &t = resHistory(pageScroll + i);
+    uint32_t totalMs = (t.releaseUs + t.acquireUs + t.enterUs) / 1000;
+    snprintf(line, sizeof(line), "%-11.11s%+6d %4ums", t.app,
+             (int)(t.freeAfter - t.freeBefore), (unsigned)totalMs);
+    u8g2.drawStr(0, 38 + i * 9, line);
+  }
+
+  u8g2.sendBuffer();
+}
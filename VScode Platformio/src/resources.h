@@ -0,0 +1,54 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef resources_H
+#define resources_H
+
+#include <stdint.h>
+
+// Shared hardware and driver resources. Every app declares the set it needs
+// (App::resources); on each screen switch the runtime releases what the next
+// app does not need and acquires what it does, so drivers and their heap do
+// not pile up as the user moves between screens.
+
+#define RES_NRF24  0x01   // VSPI bus and the three nRF24 modules
+#define RES_WIFI   0x02   // WiFi driver (STA by default, apps may switch to AP)
+#define RES_BT     0x04   // BT controller + Bluedroid, started by the app's BLEDevice::init()
+
+#define RES_HISTORY 8
+#define RES_LOW_HEAP 16384   // free heap after a switch below this lights the low memory warning
+
+struct ResTransition {
+  const char *app;          // app that was entered
+  uint8_t  held;            // resources held afterwards
+  uint32_t freeBefore;      // free 8-bit heap before the old app's exit hook
+  uint32_t freeAfter;       // ... and after the new app's enter hook
+  uint32_t largestAfter;    // largest free block afterwards
+  uint32_t releaseUs;
+  uint32_t acquireUs;
+  uint32_t enterUs;         // the app's own init time
+};
+
+// Resources already held when the runtime starts (set up by setup())
+void resSetup(uint8_t held);
+uint8_t resHeld();
+
+// Each returns the time it took in microseconds
+uint32_t resRelease(uint8_t keep);
+uint32_t resAcquire(uint8_t need);
+
+uint32_t resFreeHeap();
+uint32_t resLargestBlock();
+
+void resRecord(const ResTransition &t);
+int  resHistoryCount();
+const ResTransition &resHistory(int index);   // 0 = newest
+void resDump();
+
+// Diagnostics page
+void resPageSetup();
+void resPageLoop();
+
+#endif
@@ -0,0 +1,105 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include "rpdlevel.h"
+
+// Widest receive filter first. Bit 0 (LNA_HCURR on the nRF24L01) is don't
+// care on the nRF24L01+, the only variant with RPD, so it is no step.
+const RpdStep rpdSteps[RPD_STEPS] = {
+  { 0x0F, "2M" },
+  { 0x07, "1M" },
+  { 0x27, "250k" },
+};
+
+uint16_t rpdOffset[RPD_STEPS] = { 0, 30, 90 };
+uint8_t rpdSpread = 40;
+
+// Phi(z) x256 for z = -4 .. 4 in quarters
+static const uint16_t cdfTable[33] = {
+    0,   0,   0,   0,   0,   1,   2,   3,   6,  10,  17,  27,  41,  58,  79, 103,
+  128, 153, 177, 198, 215, 229, 239, 246, 250, 253, 254, 255, 256, 256, 256, 256,
+  256,
+};
+
+// -ln(i / 256) x64
+static const uint16_t logTable[256] = {
+  355, 355, 311, 285, 266, 252, 240, 230, 222, 214, 208, 201, 196, 191, 186, 182,
+  177, 174, 170, 166, 163, 160, 157, 154, 151, 149, 146, 144, 142, 139, 137, 135,
+  133, 131, 129, 127, 126, 124, 122, 120, 119, 117, 116, 114, 113, 111, 110, 108,
+  107, 106, 105, 103, 102, 101, 100,  98,  97,  96,  95,  94,  93,  92,  91,  90,
+   89,  88,  87,  86,  85,  84,  83,  82,  81,  80,  79,  79,  78,  77,  76,  75,
+   74,  74,  73,  72,  71,  71,  70,  69,  68,  68,  67,  66,  65,  65,  64,  63,
+   63,  62,  61,  61,  60,  60,  59,  58,  58,  57,  56,  56,  55,  55,  54,  53,
+   53,  52,  52,  51,  51,  50,  50,  49,  48,  48,  47,  47,  46,  46,  45,  45,
+   44,  44,  43,  43,  42,  42,  41,  41,  40,  40,  40,  39,  39,  38,  38,  37,
+   37,  36,  36,  36,  35,  35,  34,  34,  33,  33,  33,  32,  32,  31,  31,  30,
+   30,  30,  29,  29,  28,  28,  28,  27,  27,  27,  26,  26,  25,  25,  25,  24,
+   24,  24,  23,  23,  23,  22,  22,  21,  21,  21,  20,  20,  20,  19,  19,  19,
+   18,  18,  18,  17,  17,  17,  16,  16,  16,  15,  15,  15,  15,  14,  14,  14,
+   13,  13,  13,  12,  12,  12,  11,  11,  11,  11,  10,  10,  10,   9,   9,   9,
+    9,   8,   8,   8,   7,   7,   7,   7,   6,   6,   6,   5,   5,   5,   5,   4,
+    4,   4,   4,   3,   3,   3,   3,   2,   2,   2,   2,   1,   1,   1,   1,   0,
+};
+
+// Rounded to the nearest, also for negative a
+static inline int divRound(int a, int b) {
+  return a >= 0 ? (a + b / 2) / b : -((-a + b / 2) / b);
+}
+
+// Phi(diff / spread) x256, both in dB x10
+static int cdf(int diff, int spread) {
+  int i = 16 + divRound(4 * diff, spread);
+  return cdfTable[i < 0 ? 0 : i > 32 ? 32 : i];
+}
+
+int rpdThreshold(int step) {
+  return RPD_THRESHOLD * 10 + rpdOffset[step];
+}
+
+int rpdEstimate(const uint8_t *hits, const uint8_t *samples) {
+  int totalHits = 0;
+  int top = rpdThreshold(0);
+  for (int k = 0; k < RPD_STEPS; k++) {
+    if (!samples[k]) continue;
+    totalHits += hits[k];
+    if (rpdThreshold(k) > top) top = rpdThreshold(k);
+  }
+  if (totalHits == 0) return RPD_QUIET;
+
+  // 3 spreads either side of the thresholds, where some step can still tell
+  int spread = rpdSpread ? rpdSpread : 1;
+  int low = divRound(rpdThreshold(0) - 3 * spread, 10);
+  int high = divRound(top + 3 * spread, 10);
+
+  int best = low;
+  uint32_t bestCost = UINT32_MAX;
+  for (int p = low; p <= high; p++) {
+    int phi[RPD_STEPS];
+    int expected = 0;             // listens x Phi, x256
+    for (int k = 0; k < RPD_STEPS; k++) {
+      phi[k] = cdf(p * 10 - rpdThreshold(k), spread);
+      expected += samples[k] * phi[k];
+    }
+    if (expected == 0) continue;
+
+    // duty cycle that fits these hits best at this power, x256, at most 1
+    int duty = (int)(((uint32_t)totalHits << 16) / expected);
+    if (duty > 256) duty = 256;
+
+    // negative log likelihood of the hits, x64
+    uint32_t cost = 0;
+    for (int k = 0; k < RPD_STEPS; k++) {
+      if (!samples[k]) continue;
+      int q = duty * phi[k] >> 8;
+      q = q < 1 ? 1 : q > 255 ? 255 : q;
+      cost += hits[k] * logTable[q] + (samples[k] - hits[k]) * logTable[256 - q];
+    }
+    if (cost < bestCost) {
+      bestCost = cost;
+      best = p;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,63 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef rpdlevel_H
+#define rpdlevel_H
+
+// Coarse power estimate from the nRF24's received power detector. Takes hit
+// counts, not the radio, so tools/rpdsim.cpp can feed it simulated sweeps.
+//
+// RPD is one bit: the in-band power was above about -64 dBm during the
+// listen. A channel's hit rate mixes how often it is busy with how strong it
+// is, so a weak busy channel and a strong quiet one look the same. The
+// receive bandwidth, set by the data rate in RF_SETUP, moves the point where
+// RPD fires for a wideband source, so sampling a channel at the three data
+// rates ("steps") gives three thresholds. Step k fires with probability
+//
+//     duty * Phi((P - T_k) / spread)
+//
+// with P the channel's power while busy, T_k the step's threshold and spread
+// the variation of P from one listen to the next. rpdEstimate() finds the P
+// on a 1 dB grid that best explains the hits of all steps, with the duty
+// fitted for each P, on integer tables.
+//
+// The thresholds are a calibration table. rpdOffset[k] is step k's threshold
+// above step 0's in tenths of a dB, kept with the settings (config.cpp) so it
+// can be measured against a known source and set from the console. The
+// defaults assume a wideband source such as WiFi, which loses 3 dB for each
+// halving of the receive bandwidth; for a narrowband one they are nearer 0.
+//
+// rpdsim, rms error at 96 passes with the default table, for 1 / 2 / 3 steps:
+//
+//     at or below -66 dBm   4.0 / 5.5 / 4.2 dB
+//     -66 .. -52 dBm        7.8 / 5.4 / 4.5 dB
+//     -52 .. -40 dBm       18.0 / 10.7 / 6.2 dB
+//
+// Below the thresholds the higher steps see nothing and only take listens
+// from the first, so there the steps cost a little; the gain is all above.
+
+#include <stdint.h>
+
+#define RPD_STEPS      3
+#define RPD_THRESHOLD  (-64)      // dBm, step 0
+#define RPD_QUIET      (-128)     // no step fired
+
+struct RpdStep {
+  uint8_t rfSetup;                // RF_SETUP while listening at this step
+  const char *name;
+};
+
+extern const RpdStep rpdSteps[RPD_STEPS];
+extern uint16_t rpdOffset[RPD_STEPS];   // dB x10 above step 0, [0] stays 0
+extern uint8_t rpdSpread;               // dB x10
+
+// Step k's threshold in dBm x10
+int rpdThreshold(int step);
+
+// hits[k] out of samples[k] listens at step k, steps without samples are
+// left out. dBm, or RPD_QUIET when nothing fired.
+int rpdEstimate(const uint8_t *hits, const uint8_t *samples);
+
+#endif
@@ -0,0 +1,268 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include "scanlog.h"
+#include "diag.h"
+#include "cli.h"
+
+#define LOG_FILE        "/scanlog.bin"
+#define LOG_FILE_OLD    "/scanlog.old"
+#define LOG_MAX_BYTES   (32 * 1024)     // two files fit the 128 KB min_spiffs partition
+#define LOG_QUEUE_LEN   64
+#define LOG_BATCH_PAGES 4               // pages collected in RAM before one flash write
+#define LOG_IDLE_MS     5000            // flush a partial batch after this long
+
+static_assert(sizeof(ScanLogRecord) == 16, "ScanLogRecord must stay 16 bytes");
+static_assert(sizeof(ScanLogPage) == SCANLOG_PAGE_SIZE, "ScanLogPage must fill a page");
+
+static QueueHandle_t logQueue = nullptr;
+static volatile uint32_t dropped = 0;
+static bool mounted = false;
+
+static ScanLogPage batch[LOG_BATCH_PAGES];
+static int batchPages = 0;              // complete pages in batch
+static uint16_t session = 0;
+static uint32_t pageSeq = 0;
+static unsigned long lastFlushMs = 0;
+
+// "log ..." commands from the console, run by the log task so they never
+// race the batch it is filling
+static QueueHandle_t cmdQueue = nullptr;
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (len--) {
+    crc ^= *data++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+static bool pageValid(const ScanLogPage &page) {
+  return page.magic == SCANLOG_MAGIC && page.count <= SCANLOG_PAGE_RECORDS &&
+         page.crc == crc32((const uint8_t *)&page, offsetof(ScanLogPage, crc));
+}
+
+static void resetPage(ScanLogPage &page) {
+  memset(&page, 0, sizeof(page));
+  page.magic = SCANLOG_MAGIC;
+  page.session = session;
+  page.seq = pageSeq++;
+}
+
+// Next intact page at or after pos. An append torn by a power loss (or cut
+// short by a full partition) leaves a partial page that shifts everything
+// written after it, so past a bad page look for the next magic instead of
+// stepping a whole page.
+static bool nextPage(File &f, size_t &pos, ScanLogPage &page) {
+  size_t size = f.size();
+  while (pos + sizeof(page) <= size) {
+    f.seek(pos);
+    if (f.read((uint8_t *)&page, sizeof(page)) != sizeof(page)) return false;
+    if (pageValid(page)) {
+      pos += sizeof(page);
+      return true;
+    }
+    const uint8_t *p = (const uint8_t *)&page;
+    const uint8_t *hit = (const uint8_t *)memchr(p + 1, SCANLOG_MAGIC & 0xFF, sizeof(page) - 1);
+    pos += hit ? hit - p : sizeof(page);
+  }
+  return false;
+}
+
+// Pad a partial page left at the end of the file, so the pages appended from
+// now on start on a page boundary again
+static void alignFile() {
+  if (!SPIFFS.exists(LOG_FILE)) return;
+  File f = SPIFFS.open(LOG_FILE, "a");
+  if (!f) return;
+  size_t tail = f.size() % SCANLOG_PAGE_SIZE;
+  if (tail) {
+    uint8_t pad[SCANLOG_PAGE_SIZE];
+    memset(pad, 0xFF, sizeof(pad));
+    f.write(pad, SCANLOG_PAGE_SIZE - tail);
+  }
+  f.close();
+}
+
+// Continue the session numbering from the last intact page on flash
+static void loadSession() {
+  session = 1;
+  File f = SPIFFS.open(LOG_FILE, "r");
+  if (!f) return;
+  size_t pos = 0;
+  ScanLogPage page;
+  while (nextPage(f, pos, page)) session = page.session + 1;
+  f.close();
+}
+
+static void rotateIfFull() {
+  File f = SPIFFS.open(LOG_FILE, "r");
+  if (!f) return;
+  size_t size = f.size();
+  f.close();
+  if (size < LOG_MAX_BYTES) return;
+  SPIFFS.remove(LOG_FILE_OLD);
+  SPIFFS.rename(LOG_FILE, LOG_FILE_OLD);
+}
+
+// One append per batch keeps flash operations (and their cache stalls) rare
+static void flushBatch() {
+  DIAG_SCOPE("scanlog flush");
+  int pages = batchPages;
+  if (pages < LOG_BATCH_PAGES && batch[pages].count > 0) pages++;
+  lastFlushMs = millis();
+  if (pages == 0) return;
+
+  if (mounted) {
+    for (int i = 0; i < pages; i++) {
+      batch[i].crc = crc32((const uint8_t *)&batch[i], offsetof(ScanLogPage, crc));
+    }
+
+    rotateIfFull();
+    File f = SPIFFS.open(LOG_FILE, "a");
+    if (f) {
+      f.write((const uint8_t *)batch, pages * sizeof(ScanLogPage));
+      f.close();
+    }
+  } else {
+    // nowhere to write: drop the batch, but still start a new one so
+    // appendRecord() never runs past the end of it
+    for (int i = 0; i < pages; i++) dropped += batch[i].count;
+  }
+
+  batchPages = 0;
+  resetPage(batch[0]);
+}
+
+static void appendRecord(const ScanLogRecord &rec) {
+  ScanLogPage &page = batch[batchPages];
+  page.rec[page.count++] = rec;
+  if (page.count < SCANLOG_PAGE_RECORDS) return;
+
+  if (++batchPages == LOG_BATCH_PAGES) {
+    flushBatch();
+  } else {
+    resetPage(batch[batchPages]);
+  }
+}
+
+static void dumpFile(const char *path) {
+  File f = SPIFFS.open(path, "r");
+  if (!f) return;
+  size_t pos = 0;
+  ScanLogPage page;
+  while (nextPage(f, pos, page)) {
+    const uint8_t *p = (const uint8_t *)&page;
+    for (size_t i = 0; i < sizeof(page); i++) Serial.printf("%02x", p[i]);
+    Serial.println();
+  }
+  f.close();
+}
+
+static void handleCommand(const char *cmd) {
+  if (strcmp(cmd, "log dump") == 0) {
+    flushBatch();
+    Serial.println("#SCANLOG BEGIN");
+    dumpFile(LOG_FILE_OLD);
+    dumpFile(LOG_FILE);
+    Serial.println("#SCANLOG END");
+  } else if (strcmp(cmd, "log clear") == 0) {
+    SPIFFS.remove(LOG_FILE_OLD);
+    SPIFFS.remove(LOG_FILE);
+    Serial.println("scanlog cleared");
+  } else if (strcmp(cmd, "log stat") == 0) {
+    Serial.printf("scanlog session %u, %u pages this session, %u dropped, %u/%u bytes used\n",
+                  session, (unsigned)pageSeq, (unsigned)dropped,
+                  (unsigned)SPIFFS.usedBytes(), (unsigned)SPIFFS.totalBytes());
+  } else {
+    Serial.println("err usage: log dump|clear|stat");
+    return;
+  }
+  Serial.println("ok");
+}
+
+static void scanlogTask(void *) {
+  // mounting (and formatting on first use) takes long enough to stay off the
+  // boot path; records queued meanwhile wait in logQueue
+  mounted = SPIFFS.begin(true);
+  if (mounted) {
+    alignFile();
+    loadSession();
+  }
+
+  batchPages = 0;
+  pageSeq = 0;
+  resetPage(batch[0]);
+  lastFlushMs = millis();
+
+  ScanLogRecord rec;
+  char cmd[CLI_LINE_MAX];
+  for (;;) {
+    if (xQueueReceive(cmdQueue, cmd, 0) == pdTRUE) handleCommand(cmd);
+    if (xQueueReceive(logQueue, &rec, pdMS_TO_TICKS(100)) == pdTRUE) {
+      appendRecord(rec);
+      continue;
+    }
+    if (millis() - lastFlushMs > LOG_IDLE_MS) flushBatch();
+  }
+}
+
+void scanlogSetup() {
+  if (logQueue) return;
+
+  logQueue = xQueueCreate(LOG_QUEUE_LEN, sizeof(ScanLogRecord));
+  cmdQueue = xQueueCreate(1, CLI_LINE_MAX);
+  // low priority on core 0, away from loop() and the display
+  xTaskCreatePinnedToCore(scanlogTask, "scanlog", 4096, nullptr, 1, nullptr, 0);
+}
+
+void scanlogAdd(const ScanLogRecord &rec) {
+  if (!logQueue || xQueueSend(logQueue, &rec, 0) != pdTRUE) dropped++;
+  // everything logged is also what a console stream wants
+  if (cliStreaming()) {
+    uint8_t kind = rec.kind == SCANLOG_WIFI_AP ? CLI_STREAM_WIFI :
+                   rec.kind == SCANLOG_BLE_DEVICE ? CLI_STREAM_BLE : CLI_STREAM_SENTINEL;
+    cliStream(kind, &rec, sizeof(rec));
+  }
+}
+
+bool scanlogCommand(const char *cmd) {
+  char line[CLI_LINE_MAX];
+  strncpy(line, cmd, sizeof(line) - 1);
+  line[sizeof(line) - 1] = '\0';
+  return cmdQueue && xQueueSend(cmdQueue, line, pdMS_TO_TICKS(100)) == pdTRUE;
+}
+
+void scanlogWifi(const uint8_t *bssid, int rssi, int channel, uint8_t auth) {
+  ScanLogRecord rec;
+  rec.timeMs = millis();
+  rec.kind = SCANLOG_WIFI_AP;
+  rec.rssi = rssi;
+  rec.channel = channel;
+  rec.flags = auth;
+  rec.vendor = 0xFFFF;
+  memcpy(rec.addr, bssid, sizeof(rec.addr));
+  scanlogAdd(rec);
+}
+
+void scanlogBle(const uint8_t *addr, uint8_t addrType, int rssi, uint16_t company) {
+  ScanLogRecord rec;
+  rec.timeMs = millis();
+  rec.kind = SCANLOG_BLE_DEVICE;
+  rec.rssi = rssi;
+  rec.channel = addrType;
+  rec.flags = 0;
+  rec.vendor = company;
+  memcpy(rec.addr, addr, sizeof(rec.addr));
+  scanlogAdd(rec);
+}
+
+uint32_t scanlogDropped() {
+  return dropped;
+}
@@ -0,0 +1,63 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef scanlog_H
+#define scanlog_H
+
+#include <stdint.h>
+
+// Append-only sighting log on the SPIFFS partition.
+//
+// The file is a sequence of fixed 256-byte pages. Each page carries its own
+// CRC32, so a page torn by a power loss is detected and skipped by the
+// reader, which then finds the pages after it by their magic even though the
+// tear shifted them off the page grid. The writer pads a torn tail back to a
+// page boundary when it mounts. tools/scanlog2csv.py converts a dump to CSV.
+
+#define SCANLOG_PAGE_SIZE     256
+#define SCANLOG_PAGE_RECORDS  15
+#define SCANLOG_MAGIC         0x4C53     // "SL"
+
+enum ScanLogKind : uint8_t {
+  SCANLOG_WIFI_AP = 1,
+  SCANLOG_BLE_DEVICE = 2,
+  SCANLOG_SENTINEL = 3      // activity alert, see sentinel.h
+};
+
+struct __attribute__((packed)) ScanLogRecord {   // 16 bytes
+  uint32_t timeMs;       // millis() at the sighting
+  uint8_t  kind;         // ScanLogKind
+  int8_t   rssi;
+  uint8_t  channel;      // WiFi channel, BLE: address type, sentinel: first nRF24 channel of the worst band
+  uint8_t  flags;        // WiFi: auth mode, sentinel: bands over the baseline
+  uint16_t vendor;       // BLE company ID, 0xFFFF if unknown; sentinel: hits over the baseline
+  uint8_t  addr[6];      // BSSID / BLE address, zero for the sentinel
+};
+
+struct __attribute__((packed)) ScanLogPage {
+  uint16_t magic;
+  uint16_t session;      // incremented on every boot
+  uint32_t seq;          // page number within the session
+  uint8_t  count;        // used records
+  uint8_t  reserved[3];
+  ScanLogRecord rec[SCANLOG_PAGE_RECORDS];
+  uint32_t crc;          // CRC32 of all bytes above
+};
+
+void scanlogSetup();
+
+// Never block: records are queued for the background writer and dropped
+// if the queue is full.
+void scanlogAdd(const ScanLogRecord &rec);
+void scanlogWifi(const uint8_t *bssid, int rssi, int channel, uint8_t auth);
+void scanlogBle(const uint8_t *addr, uint8_t addrType, int rssi, uint16_t company);
+
+uint32_t scanlogDropped();
+
+// Console "log dump|clear|stat"; run later by the log task, which replies
+// on serial. False if the previous command is still pending.
+bool scanlogCommand(const char *cmd);
+
+#endif
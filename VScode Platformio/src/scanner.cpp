@@ -3,14 +3,19 @@
    https://github.com/cifertech/nrfbox
    ________________________________________ */
 
-#include <EEPROM.h> // Include EEPROM library
 #include <Arduino.h> 
 #include "scanner.h"
+#include "app.h"
+#include "diag.h"
+#include "cli.h"
+#include "config.h"
+#include "raster.h"
+#include "neopixel.h"
+#include "nrfbus.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
 #define CE  5
-#define CSN 17
 
 #define CHANNELS  64
 int channel[CHANNELS];
@@ -24,27 +29,21 @@ char grey[] = " .:-=+*aRW";
 #define _NRF24_RF_SETUP    0x06
 #define _NRF24_RPD         0x09
 
-#define EEPROM_ADDRESS_SENSOR_ARRAY 2 
-
 byte sensorArray[129];
 
 unsigned long lastSaveTime = 0; 
 const unsigned long saveInterval = 5000; 
 
+static int sweepChannel = 0;  // next channel of the sweep in progress
+
+uint8_t scannerSamples = 50;  // RPD samples per channel, set from the console
+
 byte getRegister(byte r) {
-  byte c;
-  digitalWrite(CSN, LOW);
-  SPI.transfer(r & 0x1F);
-  c = SPI.transfer(0);
-  digitalWrite(CSN, HIGH);
-  return c;
+  return nrfRead(NRF_RADIO_A, r);
 }
 
 void setRegister(byte r, byte v) {
-  digitalWrite(CSN, LOW);
-  SPI.transfer((r & 0x1F) | 0x20);
-  SPI.transfer(v);
-  digitalWrite(CSN, HIGH);
+  nrfWrite(NRF_RADIO_A, r, v);
 }
 
 void powerUp(void) {
@@ -70,26 +69,23 @@ void setRX(void) {
   delayMicroseconds(100);
 }
 
-void scanChannels(void) {
-  disable();
-
-  memset(channel, 0, sizeof(channel));
-
-  const int samplesPerChannel = 50; // Number of samples per channel to average
+// A full sweep takes ~0.8 s, so it is done a few channels per frame
+void scanChannel(int i) {
+  DIAG_SCOPE("scanner channel");
+  const int samplesPerChannel = scannerSamples ? scannerSamples : 1;
 
-  for (int i = 0; i < CHANNELS; i++) {
-    setRegister(_NRF24_RF_CH, (128 * i) / CHANNELS);
-
-    for (int j = 0; j < samplesPerChannel; j++) {
-      setRX();
-      delayMicroseconds(100); 
-      disable();
-      channel[i] += getRegister(_NRF24_RPD); // Add the RPD value (1 or 0)
-    }
+  channel[i] = 0;
+  setRegister(_NRF24_RF_CH, (128 * i) / CHANNELS);
 
-    // Average the accumulated values for this channel
-    channel[i] = (channel[i] * 100) / samplesPerChannel; // Convert to percentage
+  for (int j = 0; j < samplesPerChannel; j++) {
+    setRX();
+    delayMicroseconds(100); 
+    disable();
+    channel[i] += getRegister(_NRF24_RPD); // Add the RPD value (1 or 0)
   }
+
+  // Average the accumulated values for this channel
+  channel[i] = (channel[i] * 100) / samplesPerChannel; // Convert to percentage
 }
 
 
@@ -103,6 +99,8 @@ void outputChannels(void) {
     }
   }
 
+  ledLevel(norm);   // busiest channel, percent of samples
+
   byte drawHeight = map(norm, 0, 64, 0, 64); 
   
   // Update sensorArray with the new value (shift left for right-to-left movement)
@@ -112,23 +110,27 @@ void outputChannels(void) {
   sensorArray[0] = drawHeight;
 
   u8g2.clearBuffer();
+  {
+    DIAG_SCOPE("scanner draw");
+    uint8_t *buffer = u8g2.getBufferPtr();
 
-  u8g2.drawLine(0, 0, 0, 63);
-  u8g2.drawLine(127, 0, 127, 63);
+    rasterColumn<RasterSolid>(buffer, 0, 0, 64);
+    rasterColumn<RasterSolid>(buffer, 127, 0, 64);
 
-  for (byte count = 0; count < 64; count += 10) {
-    u8g2.drawLine(127, count, 122, count); // Right side markers
-    u8g2.drawLine(0, count, 5, count);    // Left side markers
-  }
+    for (byte count = 0; count < 64; count += 10) {
+      rasterHLine(buffer, 122, 128, count); // Right side markers
+      rasterHLine(buffer, 0, 6, count);     // Left side markers
+    }
 
-  for (byte count = 10; count < 127; count += 10) {
-    u8g2.drawPixel(count, 0);
-    u8g2.drawPixel(count, 63);
-  }
+    for (byte count = 10; count < 127; count += 10) {
+      rasterPixel(buffer, count, 0);
+      rasterPixel(buffer, count, 63);
+    }
 
-  // Draw the graph moving right-to-left
-  for (byte count = 0; count < 127; count++) {
-    u8g2.drawLine(127 - count, 63, 127 - count, 63 - sensorArray[count]);
+    // Draw the graph moving right-to-left
+    for (byte count = 0; count < 127; count++) {
+      rasterColumn<RasterSolid>(buffer, 127 - count, 63 - sensorArray[count], 64);
+    }
   }
 
   u8g2.setFont(u8g2_font_ncenB08_tr);
@@ -140,56 +142,64 @@ void outputChannels(void) {
   u8g2.sendBuffer();
 }
 
+// The graph is kept with the settings (config.h), which batch its flash
+// writes to at most one a minute
 void loadPreviousGraph() {
-  EEPROM.begin(128); 
-  for (byte i = 0; i < 128; i++) {
-    sensorArray[i] = EEPROM.read(EEPROM_ADDRESS_SENSOR_ARRAY + i);
-  }
-  EEPROM.end(); 
+  memcpy(sensorArray, configGraph(), CONFIG_GRAPH_BYTES);
 }
 
 void saveGraphToEEPROM() {
-  EEPROM.begin(128); 
-  for (byte i = 0; i < 128; i++) {
-    EEPROM.write(EEPROM_ADDRESS_SENSOR_ARRAY + i, sensorArray[i]);
-  }
-  EEPROM.commit(); 
-  EEPROM.end();    
+  if (memcmp(configGraph(), sensorArray, CONFIG_GRAPH_BYTES) == 0) return;
+  memcpy(configGraph(), sensorArray, CONFIG_GRAPH_BYTES);
+  configGraphChanged();
 }
 
 void scannerSetup() {
   Serial.begin(115200);
 
-  esp_bt_controller_deinit();
-  esp_wifi_stop();
-  esp_wifi_deinit();
-  
   for (byte count = 0; count <= 128; count++) {
     sensorArray[count] = 0;
   }
 
-  SPI.begin(18, 19, 23, 17);
-  SPI.setDataMode(SPI_MODE0);
-  SPI.setFrequency(16000000);
-  SPI.setBitOrder(MSBFIRST);
+  nrfBusClock(NRF_RADIO_A, 16000000);
+  nrfBusBegin();
 
   pinMode(CE, OUTPUT);
-  pinMode(CSN, OUTPUT);
 
   disable();
 
-  powerUp();
-  setRegister(_NRF24_EN_AA, 0x0);
-  setRegister(_NRF24_RF_SETUP, 0x0F);
+  // power-up and the receiver settings as one queued sequence
+  NrfBatch batch;
+  nrfBatchClear(batch);
+  nrfBatchWrite(batch, _NRF24_CONFIG, getRegister(_NRF24_CONFIG) | 0x02);
+  nrfBatchWrite(batch, _NRF24_EN_AA, 0x0);
+  nrfBatchWrite(batch, _NRF24_RF_SETUP, 0x0F);
+  nrfBatchRun(NRF_RADIO_A, batch);
+  delayMicroseconds(130);
 
   loadPreviousGraph();
+  sweepChannel = 0;
 }
 
 void scannerLoop() {
-  scanChannels();
+  if (sweepChannel == 0) disable();
+  nrfBusAcquire(NRF_RADIO_A);
+  while (sweepChannel < CHANNELS && appBudgetLeft()) {
+    scanChannel(sweepChannel++);
+  }
+  nrfBusRelease(NRF_RADIO_A);
+  if (sweepChannel < CHANNELS) return;
+
+  sweepChannel = 0;
   outputChannels();
 
-  // Save the graph to EEPROM every 5 seconds
+  if (cliStreaming()) {
+    uint8_t levels[CHANNELS];
+    for (int i = 0; i < CHANNELS; i++) levels[i] = channel[i];
+    cliStream(CLI_STREAM_SCANNER, levels, CHANNELS);
+  }
+
+  // Hand the graph to the settings store every 5 seconds
   if (millis() - lastSaveTime > saveInterval) {
     saveGraphToEEPROM();
     lastSaveTime = millis();
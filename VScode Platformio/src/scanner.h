@@ -12,6 +12,8 @@
 #include "esp_bt.h"
 #include "esp_wifi.h"
 
+extern uint8_t scannerSamples;
+
 void scannerSetup();
 void scannerLoop();
 
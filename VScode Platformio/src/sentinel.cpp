@@ -0,0 +1,242 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "sentinel.h"
+#include "app.h"
+#include "power.h"
+#include "scanlog.h"
+#include "raster.h"
+#include "neopixel.h"
+#include "nrfbus.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+#define CE  5
+
+#define BUTTON_LEFT_PIN   25
+
+#define NRF24_CONFIG      0x00
+#define NRF24_EN_AA       0x01
+#define NRF24_RF_CH       0x05
+#define NRF24_RF_SETUP    0x06
+#define NRF24_RPD         0x09
+
+#define CHANNELS          128
+#define BAND_CHANNELS     (CHANNELS / SENTINEL_BANDS)
+
+uint16_t sentinelPeriodSec = 10;
+uint8_t sentinelMargin = 4;
+
+static uint8_t hits[SENTINEL_BANDS];        // sweep in progress / last sweep
+static uint16_t baseline[SENTINEL_BANDS];   // expected hits, x16
+static int learned = 0;                     // sweeps folded into the baseline
+
+static bool sweeping = false;
+static int sweepPass = 0;
+static int sweepChannel = 0;
+static uint32_t nextSweepMs = 0;
+static uint32_t sweepUs = 0;                // duration of the last sweep
+
+static uint32_t alerts = 0;
+static uint32_t lastAlertMs = 0;
+static int lastAlertBand = -1;
+
+static uint8_t readReg(uint8_t reg) {
+  return nrfRead(NRF_RADIO_A, reg);
+}
+
+static void writeReg(uint8_t reg, uint8_t value) {
+  nrfWrite(NRF_RADIO_A, reg, value);
+}
+
+static void radioOn() {
+  writeReg(NRF24_CONFIG, (readReg(NRF24_CONFIG) | 0x02) | 0x01);   // PWR_UP, PRIM_RX
+  delayMicroseconds(1500);                                          // oscillator start-up
+}
+
+static void radioOff() {
+  digitalWrite(CE, LOW);
+  writeReg(NRF24_CONFIG, readReg(NRF24_CONFIG) & ~0x02);
+}
+
+static void startSweep() {
+  memset(hits, 0, sizeof(hits));
+  sweepPass = 0;
+  sweepChannel = 0;
+  sweepUs = 0;
+  sweeping = true;
+  radioOn();
+}
+
+// Compares the finished sweep to the baseline and folds quiet sweeps into it
+static void evaluateSweep() {
+  if (learned < SENTINEL_LEARN_SWEEPS) {
+    learned++;
+    for (int b = 0; b < SENTINEL_BANDS; b++) {
+      baseline[b] = baseline[b] + ((hits[b] << 4) - baseline[b]) / learned;
+    }
+    return;
+  }
+
+  int over = 0;
+  int worst = -1;
+  int worstExcess = 0;
+  for (int b = 0; b < SENTINEL_BANDS; b++) {
+    int excess = hits[b] - ((baseline[b] + 8) >> 4);
+    if (excess >= sentinelMargin) {
+      over++;
+      if (excess > worstExcess) {
+        worstExcess = excess;
+        worst = b;
+      }
+    }
+  }
+
+  if (over == 0) {
+    // slow drift (a neighbour's router coming up) should not alert forever
+    for (int b = 0; b < SENTINEL_BANDS; b++) {
+      baseline[b] = baseline[b] + ((hits[b] << 4) - baseline[b]) / 8;
+    }
+    return;
+  }
+
+  alerts++;
+  lastAlertMs = millis();
+  lastAlertBand = worst;
+  Serial.printf("sentinel alert: %d band(s) over baseline, worst ch %d-%d +%d hits\n",
+                over, worst * BAND_CHANNELS, worst * BAND_CHANNELS + BAND_CHANNELS - 1, worstExcess);
+
+  ScanLogRecord rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.timeMs = lastAlertMs;
+  rec.kind = SCANLOG_SENTINEL;
+  rec.channel = worst * BAND_CHANNELS;
+  rec.flags = over;
+  rec.vendor = worstExcess;
+  scanlogAdd(rec);
+  ledStatus(LED_TRIGGER);
+}
+
+static void draw() {
+  char line[32];
+  u8g2.clearBuffer();
+  u8g2.setFont(u8g2_font_5x8_tr);
+
+  if (learned < SENTINEL_LEARN_SWEEPS) {
+    snprintf(line, sizeof(line), "Sentinel  learning %d/%d", learned, SENTINEL_LEARN_SWEEPS);
+  } else {
+    snprintf(line, sizeof(line), "Sentinel  every %us", sentinelPeriodSec);
+  }
+  u8g2.drawStr(0, 8, line);
+  snprintf(line, sizeof(line), "alerts %u", (unsigned)alerts);
+  u8g2.drawStr(0, 17, line);
+  if (lastAlertBand >= 0) {
+    snprintf(line, sizeof(line), "last %us ago ch%d", (unsigned)((millis() - lastAlertMs) / 1000),
+             lastAlertBand * BAND_CHANNELS);
+    u8g2.drawStr(0, 26, line);
+  }
+
+  // last sweep as bars, halftone up to the baseline and solid above it,
+  // baseline as a tick across each bar
+  const int bottom = 63;
+  const int scale = 24;     // pixels for BAND_CHANNELS * SENTINEL_PASSES hits
+  const int full = BAND_CHANNELS * SENTINEL_PASSES;
+  uint8_t *buffer = u8g2.getBufferPtr();
+  for (int b = 0; b < SENTINEL_BANDS; b++) {
+    int x = b * 8;
+    int h = hits[b] * scale / full;
+    int base = ((baseline[b] + 8) >> 4) * scale / full;
+    for (int c = x + 1; c < x + 7; c++) {
+      rasterColumn<RasterHalftone>(buffer, c, bottom - min(h, base), bottom);
+      rasterColumn<RasterSolid>(buffer, c, bottom - h, bottom - base);
+    }
+    rasterHLine(buffer, x, x + 8, bottom - base - 1);
+  }
+
+  u8g2.sendBuffer();
+}
+
+void sentinelSetup() {
+  pinMode(CE, OUTPUT);
+  digitalWrite(CE, LOW);
+
+  nrfBusClock(NRF_RADIO_A, 10000000);
+  nrfBusBegin();
+  nrfBusAcquire(NRF_RADIO_A);
+  writeReg(NRF24_EN_AA, 0x00);
+  writeReg(NRF24_RF_SETUP, 0x0F);
+  radioOff();
+  nrfBusRelease(NRF_RADIO_A);
+
+  memset(hits, 0, sizeof(hits));
+  memset(baseline, 0, sizeof(baseline));
+  learned = 0;
+  alerts = 0;
+  lastAlertBand = -1;
+  sweeping = false;
+  nextSweepMs = millis();
+}
+
+void sentinelLoop() {
+  if (!sweeping && (int32_t)(millis() - nextSweepMs) >= 0) {
+    nrfBusAcquire(NRF_RADIO_A);
+    startSweep();
+    nrfBusRelease(NRF_RADIO_A);
+  }
+
+  if (sweeping) {
+    uint32_t start = micros();
+    nrfBusAcquire(NRF_RADIO_A);
+    while (sweepPass < SENTINEL_PASSES && appBudgetLeft()) {
+      writeReg(NRF24_RF_CH, sweepChannel);
+      digitalWrite(CE, HIGH);
+      delayMicroseconds(128);
+      digitalWrite(CE, LOW);
+      if (readReg(NRF24_RPD) & 0x01) hits[sweepChannel / BAND_CHANNELS]++;
+      if (++sweepChannel == CHANNELS) {
+        sweepChannel = 0;
+        sweepPass++;
+      }
+    }
+    bool done = sweepPass == SENTINEL_PASSES;
+    if (done) radioOff();
+    nrfBusRelease(NRF_RADIO_A);
+    sweepUs += micros() - start;
+
+    if (!done) {
+      powerBusy();      // the rest of the sweep runs next frame, not after a sleep
+    } else {
+      sweeping = false;
+      nextSweepMs = millis() + sentinelPeriodSec * 1000UL;
+      evaluateSweep();
+      appInvalidate();
+    }
+  }
+
+  if (appRedraw()) {
+    draw();
+    appInvalidateIn(1000);    // "last alert" age
+  }
+
+  // LEFT starts learning over, e.g. after moving the box
+  if (appPressed(BUTTON_LEFT_PIN)) {
+    learned = 0;
+    memset(baseline, 0, sizeof(baseline));
+    nextSweepMs = millis();
+  }
+}
+
+void sentinelStop() {
+  sweeping = false;
+  nrfBusAcquire(NRF_RADIO_A);
+  radioOff();
+  nrfBusRelease(NRF_RADIO_A);
+}
+
+uint32_t sentinelAlerts() {
+  return alerts;
+}
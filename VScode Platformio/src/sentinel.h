@@ -0,0 +1,36 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef sentinel_H
+#define sentinel_H
+
+#include <stdint.h>
+
+// Low-duty-cycle activity monitor.
+//
+// Every sentinelPeriodSec the screen powers up one nRF24 module and does a
+// short RPD sweep of the 2.4 GHz band. The sweep takes about 80 ms. Then the
+// module goes back to power-down. The first SENTINEL_LEARN_SWEEPS sweeps learn
+// a per-band baseline. Later sweeps that exceed it by sentinelMargin hits
+// raise an alert on serial and in the scan log (SCANLOG_SENTINEL). Quiet
+// sweeps keep adapting the baseline slowly. Between sweeps the app only waits,
+// so once the display times out the power manager light-sleeps (power.h).
+
+#define SENTINEL_BANDS        16      // 8 channels each
+#define SENTINEL_PASSES       4       // RPD samples per channel and sweep
+#define SENTINEL_LEARN_SWEEPS 8
+
+// Set from the console
+extern uint16_t sentinelPeriodSec;
+extern uint8_t sentinelMargin;
+
+void sentinelSetup();
+void sentinelLoop();
+void sentinelStop();
+
+// Alerts since the screen was entered
+uint32_t sentinelAlerts();
+
+#endif
@@ -3,71 +3,62 @@
    https://github.com/cifertech/nrfbox
    ________________________________________ */
 
-#include <EEPROM.h>
 #include <U8g2lib.h>
 
 #include "setting.h"
+#include "bledevices.h"
+#include "app.h"
+#include "config.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
 #define BUTTON_UP 26
 #define BUTTON_DOWN 33
 #define BUTTON_SELECT 27
-#define EEPROM_ADDRESS_BRIGHTNESS 1
 
 int currentOption = 0;
-int totalOptions = 2;
-uint8_t oledBrightness = 100;
+int totalOptions = 3;
+uint8_t oledBrightness = 128;
+uint8_t neoPixelActive = 0;
 
-bool buttonUpPressed = false;
-bool buttonDownPressed = false;
-bool buttonSelectPressed = false;
+void settingApplyBrightness() {
+  u8g2.setContrast(oledBrightness);
+}
 
+// Changes only touch RAM; config.cpp commits them once the buttons go quiet
 void toggleOption(int option) {
   if (option == 0) { 
-    EEPROM.commit();
+    configCommit();
   } else if (option == 1) { 
     uint8_t brightnessPercent = map(oledBrightness, 0, 255, 0, 100); // Map to 0-100
     brightnessPercent += 10; // Increment brightness by 10%
-    if (brightnessPercent > 100) brightnessPercent = 0; // Wrap around to 0
+    if (brightnessPercent > 100) brightnessPercent = 10; // Wrap around to 10, 0 looks like a dead screen
     oledBrightness = map(brightnessPercent, 0, 100, 0, 255); // Map back to 0-255
-
-    u8g2.setContrast(oledBrightness); // Apply the brightness
-    EEPROM.write(EEPROM_ADDRESS_BRIGHTNESS, oledBrightness);
-    EEPROM.commit();
+    settingApplyBrightness();
+    configChanged();
 
     Serial.print("Brightness set to: ");
     Serial.print(brightnessPercent);
     Serial.println("%");
+  } else if (option == 2) {
+    bleScanProfile = (bleScanProfile + 1) % BLE_PROFILE_COUNT;
+    configChanged();
+
+    Serial.print("BLE scan profile: ");
+    Serial.println(bleProfileDef(bleScanProfile).name);
   }
 }
 
 void handleButtons() {
-  if (!digitalRead(BUTTON_UP)) {
-    if (!buttonUpPressed) {
-      buttonUpPressed = true;
-      currentOption = (currentOption - 1 + totalOptions) % totalOptions;
-    }
-  } else {
-    buttonUpPressed = false;
+  if (appPressedRepeat(BUTTON_UP)) {
+    currentOption = (currentOption - 1 + totalOptions) % totalOptions;
   }
-
-  if (!digitalRead(BUTTON_DOWN)) {
-    if (!buttonDownPressed) {
-      buttonDownPressed = true;
-      currentOption = (currentOption + 1) % totalOptions;
-    }
-  } else {
-    buttonDownPressed = false;
+  if (appPressedRepeat(BUTTON_DOWN)) {
+    currentOption = (currentOption + 1) % totalOptions;
   }
-
-  if (!digitalRead(BUTTON_SELECT)) {
-    if (!buttonSelectPressed) {
-      buttonSelectPressed = true;
-      toggleOption(currentOption);
-    }
-  } else {
-    buttonSelectPressed = false;
+  // held on brightness, it keeps stepping
+  if (currentOption == 1 ? appPressedRepeat(BUTTON_SELECT) : appPressed(BUTTON_SELECT)) {
+    toggleOption(currentOption);
   }
 }
 
@@ -93,28 +84,37 @@ void displayMenu() {
   u8g2.print(brightnessPercent);
   u8g2.print("%");
 
+  if (currentOption == 2) {
+    u8g2.drawStr(0, 52, "> BLE: ");
+  } else {
+    u8g2.drawStr(0, 52, "  BLE: ");
+  }
+  u8g2.drawStr(42, 52, bleProfileDef(bleScanProfile).name);
+
+  // duty cycle, plus discovery latency of the last scan run with this profile
+  u8g2.setFont(u8g2_font_5x8_tr);
+  u8g2.setCursor(12, 62);
+  u8g2.print("duty ");
+  u8g2.print(bleProfileDutyPercent(bleScanProfile));
+  u8g2.print("%");
+  const BleScanStats &stats = bledevicesLastStats();
+  if (stats.profile == bleScanProfile && stats.devices > 0) {
+    u8g2.print("  p90 ");
+    u8g2.print(stats.p90Ms);
+    u8g2.print("ms");
+  }
+
   u8g2.sendBuffer();
 }
 
 void settingSetup() {
   Serial.begin(115200);
 
-  // Initialize EEPROM
-  EEPROM.begin(512);
-
-  // Load settings from EEPROM
-  oledBrightness = EEPROM.read(EEPROM_ADDRESS_BRIGHTNESS);
-  
-  if (oledBrightness > 255) oledBrightness = 128; // Ensure valid brightness
-  u8g2.setContrast(oledBrightness);
-
-  // Initialize buttons
-  pinMode(BUTTON_UP, INPUT_PULLUP);
-  pinMode(BUTTON_DOWN, INPUT_PULLUP);
-  pinMode(BUTTON_SELECT, INPUT_PULLUP);
+  // Settings were loaded and range checked at boot (config.cpp)
+  settingApplyBrightness();
 }
 
 void settingLoop() {
   handleButtons();
-  displayMenu();
+  if (appRedraw()) displayMenu();
 }
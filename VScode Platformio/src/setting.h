@@ -9,7 +9,12 @@
 #include <BLEDevice.h>
 #include <U8g2lib.h>
 
+// Persisted by config.h
+extern uint8_t oledBrightness;
+extern uint8_t neoPixelActive;
+
 void settingSetup();
 void settingLoop();
+void settingApplyBrightness();
 
 #endif
@@ -0,0 +1,121 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <string.h>
+#include "snakecore.h"
+
+static uint32_t nextRandom(SnakeState &s) {
+  uint32_t x = s.rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  s.rng = x;
+  return x;
+}
+
+static inline void occupy(SnakeState &s, uint16_t cell) {
+  s.occupied[snakeCellY(cell)] |= (uint32_t)1 << snakeCellX(cell);
+}
+
+static inline void vacate(SnakeState &s, uint16_t cell) {
+  s.occupied[snakeCellY(cell)] &= ~((uint32_t)1 << snakeCellX(cell));
+}
+
+// The rank-th free cell in row order: whole rows are skipped by popcount,
+// then the bit is found inside the row
+static uint16_t freeCell(const SnakeState &s, int rank) {
+  for (int y = 0; y < SNAKE_ROWS; y++) {
+    uint32_t free = ~s.occupied[y];
+    int n = __builtin_popcount(free);
+    if (rank >= n) {
+      rank -= n;
+      continue;
+    }
+    while (rank--) free &= free - 1;    // drop the lowest free bits
+    return snakeCell(__builtin_ctz(free), y);
+  }
+  return SNAKE_NONE;
+}
+
+static void placeFood(SnakeState &s) {
+  int free = SNAKE_CELLS - s.length;
+  s.food = free > 0 ? freeCell(s, nextRandom(s) % free) : SNAKE_NONE;
+  s.newFood = s.food;
+}
+
+void snakeReset(SnakeState &s, uint32_t seed, bool wrap) {
+  memset(s.occupied, 0, sizeof(s.occupied));
+  s.rng = seed ? seed : 0x9E3779B9;
+  s.wrap = wrap;
+  s.dir = s.nextDir = SNAKE_RIGHT;
+
+  // tail first, so the head ends up at body[SNAKE_START - 1]
+  for (int i = 0; i < SNAKE_START; i++) {
+    uint16_t cell = snakeCell(SNAKE_COLS / 2 - (SNAKE_START - 1) + i, SNAKE_ROWS / 2);
+    s.body[i] = cell;
+    occupy(s, cell);
+  }
+  s.head = SNAKE_START - 1;
+  s.length = SNAKE_START;
+  s.newHead = s.body[s.head];
+  s.vacated = SNAKE_NONE;
+  placeFood(s);
+}
+
+bool snakeSteer(SnakeState &s, SnakeDir dir) {
+  // UP/DOWN are 0/1 and LEFT/RIGHT 2/3: the same axis shares bit 1
+  if ((dir >> 1) == (s.dir >> 1)) return false;
+  s.nextDir = dir;
+  return true;
+}
+
+SnakeEvent snakeStep(SnakeState &s) {
+  static const int8_t stepX[] = { 0, 0, -1, 1 };
+  static const int8_t stepY[] = { -1, 1, 0, 0 };
+
+  uint16_t cell = s.body[s.head];
+  int x = snakeCellX(cell) + stepX[s.nextDir];
+  int y = snakeCellY(cell) + stepY[s.nextDir];
+  if (x < 0 || x >= SNAKE_COLS || y < 0 || y >= SNAKE_ROWS) {
+    if (!s.wrap) return SNAKE_DIED;
+    x = (x + SNAKE_COLS) % SNAKE_COLS;
+    y = (y + SNAKE_ROWS) % SNAKE_ROWS;
+  }
+  uint16_t next = snakeCell(x, y);
+  bool ate = next == s.food;
+
+  // the tail moves out first, so following it closely is allowed
+  uint16_t tail = snakeSegment(s, s.length - 1);
+  if (!ate) vacate(s, tail);
+  if (snakeOccupied(s, next)) {
+    if (!ate) occupy(s, tail);
+    return SNAKE_DIED;
+  }
+
+  s.dir = s.nextDir;
+  s.head = (s.head + 1) & (SNAKE_CELLS - 1);
+  s.body[s.head] = next;
+  occupy(s, next);
+  s.newHead = next;
+  s.vacated = ate ? SNAKE_NONE : tail;
+  s.newFood = SNAKE_NONE;
+  if (!ate) return SNAKE_MOVED;
+
+  s.length++;
+  placeFood(s);
+  return s.food == SNAKE_NONE ? SNAKE_WON : SNAKE_ATE;
+}
+
+uint32_t snakeHash(const SnakeState &s) {
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < s.length; i++) {
+    uint16_t cell = snakeSegment(s, i);
+    h = (h ^ (cell & 0xFF)) * 16777619u;
+    h = (h ^ (cell >> 8)) * 16777619u;
+  }
+  h = (h ^ s.food) * 16777619u;
+  h = (h ^ s.rng) * 16777619u;
+  return h;
+}
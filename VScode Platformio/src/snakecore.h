@@ -0,0 +1,81 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef snakecore_H
+#define snakecore_H
+
+// Snake rules, separate from the screen (SnakeGame.cpp), so the game can run
+// without a display: tools/snakebench.cpp plays seeded games headless on a
+// PC to time the step and compare replays.
+//
+// The body is a ring buffer of cell indices and the board a 32x16
+// occupancy bitmap, one word per row, so a step and its collision check cost
+// the same at any length. Food is drawn uniformly from the free cells by
+// rank (popcount per row, then the bit within the row), so placement stays
+// bounded even when the board is nearly full. All randomness comes from the
+// state's own xorshift32 generator: the same seed and the same turns give
+// the same game.
+
+#include <stdint.h>
+
+#define SNAKE_COLS   32
+#define SNAKE_ROWS   16
+#define SNAKE_CELLS  (SNAKE_COLS * SNAKE_ROWS)   // power of two, the ring wraps with a mask
+#define SNAKE_START  3
+#define SNAKE_NONE   0xFFFF                     // no cell
+
+enum SnakeDir : uint8_t { SNAKE_UP, SNAKE_DOWN, SNAKE_LEFT, SNAKE_RIGHT };
+
+enum SnakeEvent : uint8_t {
+  SNAKE_MOVED,
+  SNAKE_ATE,
+  SNAKE_DIED,     // wall (without wrap) or own body; the state is left as it was
+  SNAKE_WON,      // the body fills the board
+};
+
+struct SnakeState {
+  uint16_t body[SNAKE_CELLS];       // ring of cells, body[head] is the head
+  uint32_t occupied[SNAKE_ROWS];    // bit x of word y: cell (x, y) holds the body
+  uint16_t head;
+  uint16_t length;
+  uint16_t food;                    // SNAKE_NONE once the board is full
+  SnakeDir dir;
+  SnakeDir nextDir;                 // applied on the next step
+  bool wrap;                        // walls wrap around instead of killing
+  uint32_t rng;
+
+  // cells the last step changed, for drawing only those
+  uint16_t newHead;
+  uint16_t vacated;                 // former tail cell, SNAKE_NONE when the snake grew
+  uint16_t newFood;                 // SNAKE_NONE when the food stayed
+};
+
+static inline uint16_t snakeCell(int x, int y) { return (uint16_t)(y * SNAKE_COLS + x); }
+static inline int snakeCellX(uint16_t cell) { return cell % SNAKE_COLS; }
+static inline int snakeCellY(uint16_t cell) { return cell / SNAKE_COLS; }
+
+static inline bool snakeOccupied(const SnakeState &s, uint16_t cell) {
+  return s.occupied[snakeCellY(cell)] >> snakeCellX(cell) & 1;
+}
+
+// i = 0 is the head, length - 1 the tail
+static inline uint16_t snakeSegment(const SnakeState &s, int i) {
+  return s.body[(s.head - i) & (SNAKE_CELLS - 1)];
+}
+
+// Three cells in the middle of the board heading right. seed 0 is replaced
+// by a fixed non-zero value, xorshift never leaves 0.
+void snakeReset(SnakeState &s, uint32_t seed, bool wrap);
+
+// A quarter turn from the current heading, taken on the next step. False
+// (and ignored) for the heading itself or a reversal onto the body.
+bool snakeSteer(SnakeState &s, SnakeDir dir);
+
+SnakeEvent snakeStep(SnakeState &s);
+
+// FNV-1a over the body, food and generator, to compare replays
+uint32_t snakeHash(const SnakeState &s);
+
+#endif
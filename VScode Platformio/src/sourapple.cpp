@@ -5,6 +5,7 @@
    
 #include <Arduino.h> 
 #include "sourapple.h"
+#include "fmt.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -14,50 +15,38 @@ BLEAdvertising *Advertising;
 uint8_t packet[17];
 
 #define MAX_LINES 8
-String lines[MAX_LINES];
+static char lines[MAX_LINES][FMT_LINE];
 int currentLine = 0;
 int lineNumber = 1;
 
 uint32_t delayMilliseconds = 1000;
 
+static bool advRunning = false;     // a 40 ms advertising burst is on air
+static unsigned long advStartMs = 0;
+
 void updatedisplay() {
   u8g2.clearBuffer();
 
   for (int i = 0; i < MAX_LINES; i++) {
-    u8g2.setCursor(0, (i + 1) * 12);
-    u8g2.print(lines[i]);
+    u8g2.drawStr(0, (i + 1) * 12, lines[i]);
   }
 
   u8g2.sendBuffer();
   Advertising->stop();
 }
 
-void addLineToDisplay(String newLine) {
-  for (int i = 0; i < MAX_LINES - 1; i++) {
-    lines[i] = lines[i + 1];
-  }
-  lines[MAX_LINES - 1] = newLine;
-
-  updatedisplay();
+// Scrolls the log up by one row; the new row is written in place
+static char *addLineToDisplay() {
+  memmove(lines[0], lines[1], sizeof(lines) - sizeof(lines[0]));
+  return lines[MAX_LINES - 1];
 }
 
 void displayAdvertisementData() {
-  String lineStr = String(lineNumber) + ": ";
+  // line number, then type, company ID and action type of the advertisement
+  fmt(addLineToDisplay(), FMT_LINE, "%d: 0x%x,0x%x%x,0x%x",
+      lineNumber, packet[1], packet[2], packet[3], packet[7]);
   lineNumber++;
-  // Convert the advertisement data to a readable string format
-  //String dataStr = "Type: 0x";
-  String dataStr = "0x";
-  dataStr += String(packet[1], HEX);
-  //dataStr += ", CompID: 0x";
-  dataStr += ",0x";
-  dataStr += String(packet[2], HEX);
-  dataStr += String(packet[3], HEX);
-  //dataStr += ", ActType: 0x";
-  dataStr += ",0x";
-  dataStr += String(packet[7], HEX);
-
-  addLineToDisplay(lineStr + dataStr);
-
+  updatedisplay();
 }
 
 BLEAdvertisementData getOAdvertisementData() {
@@ -98,12 +87,23 @@ void sourappleSetup() {
 
   esp_bd_addr_t null_addr = {0xFE, 0xED, 0xC0, 0xFF, 0xEE, 0x69};
   Advertising->setDeviceAddress(null_addr, BLE_ADDR_TYPE_RANDOM);
+  advRunning = false;
+}
 
-
+void sourappleStop() {
+  advRunning = false;
+  Advertising->stop();
 }
 
 void sourappleLoop() {
 
+    if (advRunning) {
+      if (millis() - advStartMs < 40) return;
+      advRunning = false;
+      displayAdvertisementData();  // stops the burst
+      return;
+    }
+
     esp_bd_addr_t dummy_addr = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
     for (int i = 0; i < 6; i++) {
       dummy_addr[i] = random(256);
@@ -123,8 +123,6 @@ void sourappleLoop() {
     Advertising->setMaxPreferred(0x20);
 
     Advertising->start();
-
-    delay(40);
-    displayAdvertisementData();
-  
+    advRunning = true;
+    advStartMs = millis();
 }
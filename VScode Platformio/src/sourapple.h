@@ -13,5 +13,6 @@
 
 void sourappleSetup();
 void sourappleLoop();
+void sourappleStop();
 
 #endif
@@ -5,6 +5,7 @@
    
 #include <Arduino.h> 
 #include "spoofer.h"
+#include "app.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -18,21 +19,10 @@ const int advTypeNextPin = 33;
 const int advControlPin = 26;     
 
 uint32_t delayMillisecond = 1000;
-unsigned long lastDebounceTimeNext = 0;
-unsigned long lastDebounceTimePrev = 0;
-unsigned long lastDebounceTimeAdvNext = 0;
-unsigned long lastDebounceTimeAdvPrev = 0;
-
-int lastButtonStateNext = LOW;
-int lastButtonStatePrev = LOW;
-int lastButtonStateAdvNext = LOW;
-int lastButtonStateAdvPrev = LOW;
-
-
-unsigned long lastDebounceTime = 0;
-unsigned long debounceDelay = 500; 
 
 bool isAdvertising = true; 
+static bool advBurst = false;         // a timed advertising burst is running
+static unsigned long advStopMs = 0;
 
 int scanTime = 5;
 int deviceType = 1;
@@ -364,17 +354,9 @@ void setAdvertisingData() {
 
 
 void handleButtonPress(int pin, void (*callback)()) {
-  int reading = digitalRead(pin);
-
-  if (reading == LOW) {
-    unsigned long currentTime = millis();
-    delay(300);
+  if (appPressed(pin)) {
     updateDisplay();
-
-    if ((currentTime - lastDebounceTime) > debounceDelay) {
-      callback();
-      lastDebounceTime = currentTime;
-    }
+    callback();
   }
 }
 
@@ -417,6 +399,7 @@ void toggleAdvertising() {
   isAdvertising = !isAdvertising;
   
   if (!isAdvertising) {
+    advBurst = false;
     pAdvertising->stop();
     Serial.println("Advertising stopped.");
     updateDisplay();
@@ -444,19 +427,13 @@ void toggleAdvertising() {
       pAdvertising->setMaxPreferred(0x20);
 
       pAdvertising->start();
-      delay(delayMillisecond); // delay for delayMillisecond ms
-      pAdvertising->stop();
+      // stopped by spooferLoop() after delayMillisecond ms
+      advBurst = true;
+      advStopMs = millis() + delayMillisecond;
     }
 
     Serial.println("Advertising started.");
     updateDisplay();
-    
-    if (digitalRead(advControlPin) == LOW) {
-      delay(50);  // Debounce delay
-      isAdvertising = !isAdvertising;
-      updateDisplay(); 
-      //break;  
-    }
   }
    //isAdvertising = !isAdvertising;
 }
@@ -464,12 +441,6 @@ void toggleAdvertising() {
 
 void spooferSetup() {
 
-  pinMode(deviceTypeNextPin, INPUT_PULLUP);
-  pinMode(deviceTypePrevPin, INPUT_PULLUP);
-  pinMode(advTypeNextPin, INPUT_PULLUP);
-  //pinMode(advTypePrevPin, INPUT_PULLUP);
-  pinMode(advControlPin, INPUT_PULLUP);
-
   BLEDevice::init("AirPods 69");
   esp_ble_tx_power_set(ESP_BLE_PWR_TYPE_ADV, ESP_PWR_LVL_P9);
   updateDisplay();
@@ -478,8 +449,12 @@ void spooferSetup() {
 
   esp_bd_addr_t null_addr = {0xFE, 0xED, 0xC0, 0xFF, 0xEE, 0x69};
   pAdvertising->setDeviceAddress(null_addr, BLE_ADDR_TYPE_RANDOM);
-  delay(500);
+  advBurst = false;
+}
 
+void spooferStop() {
+  advBurst = false;
+  pAdvertising->stop();
 }
 
 void spooferLoop() {
@@ -490,5 +465,8 @@ void spooferLoop() {
   //handleButtonPress(advTypePrevPin, changeAdvTypePrev);
   handleButtonPress(advControlPin, toggleAdvertising); 
 
-  delay(50); // Avoid overloading the CPU
+  if (advBurst && (long)(millis() - advStopMs) >= 0) {
+    advBurst = false;
+    pAdvertising->stop();
+  }
 }
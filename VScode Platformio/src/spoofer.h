@@ -13,5 +13,6 @@
 
 void spooferSetup();
 void spooferLoop();
+void spooferStop();
 
 #endif
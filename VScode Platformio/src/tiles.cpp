@@ -0,0 +1,147 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "tiles.h"
+#include "diag.h"
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+
+struct CacheSlot {
+  const TileImage *image;
+  uint32_t used;              // cacheClock at the last hit, for LRU eviction
+  uint8_t pages[TILE_CACHE_BYTES];
+};
+
+static CacheSlot cache[TILE_CACHE_SLOTS];
+static uint32_t cacheClock = 0;
+static uint32_t cacheHits = 0;
+static uint32_t cacheMisses = 0;
+
+// Where the image lands in the buffer, clipped to it
+struct Blit {
+  uint8_t *buffer;
+  int bufferWidth;
+  int bufferPages;
+  int x;
+  int left, right;            // visible columns, in buffer coordinates
+  int page;                   // buffer page of the image's first page
+  int shift;                  // bit offset of the image's top row in that page
+};
+
+static bool blitSetup(Blit &b, const TileImage &image, int x, int y) {
+  b.buffer = u8g2.getBufferPtr();
+  b.bufferWidth = u8g2.getBufferTileWidth() * 8;
+  b.bufferPages = u8g2.getBufferTileHeight();
+  b.x = x;
+  b.left = x < 0 ? 0 : x;
+  b.right = x + image.width < b.bufferWidth ? x + image.width : b.bufferWidth;
+  // rounded down for negative y
+  b.page = y >= 0 ? y / 8 : -((7 - y) / 8);
+  b.shift = y - b.page * 8;
+  return b.left < b.right;
+}
+
+static void blitPages(const Blit &b, const uint8_t *pages, int width, int count) {
+  int columns = b.right - b.left;
+  int page = b.page;
+  for (int p = 0; p < count; p++, page++) {
+    const uint8_t *src = pages + p * width + (b.left - b.x);
+    if (page >= 0 && page < b.bufferPages) {
+      uint8_t *dst = b.buffer + page * b.bufferWidth + b.left;
+      for (int i = 0; i < columns; i++) dst[i] |= (uint8_t)(src[i] << b.shift);
+    }
+    if (b.shift && page + 1 >= 0 && page + 1 < b.bufferPages) {
+      uint8_t *dst = b.buffer + (page + 1) * b.bufferWidth + b.left;
+      for (int i = 0; i < columns; i++) dst[i] |= src[i] >> (8 - b.shift);
+    }
+  }
+}
+
+// One decoded byte at image column `column` of image page `p`
+static inline void blitByte(const Blit &b, int p, int column, uint8_t value) {
+  int x = b.x + column;
+  if (x < b.left || x >= b.right) return;
+  int page = b.page + p;
+  if (page >= 0 && page < b.bufferPages) b.buffer[page * b.bufferWidth + x] |= (uint8_t)(value << b.shift);
+  if (b.shift && page + 1 >= 0 && page + 1 < b.bufferPages) {
+    b.buffer[(page + 1) * b.bufferWidth + x] |= value >> (8 - b.shift);
+  }
+}
+
+// Run-length stream (see tools/xbm2tiles.py): 0x00..0x7f n + 1 literals
+// follow, 0x80..0xff the next byte n - 0x7e times
+static void unpackTo(const TileImage &image, const Blit *b, uint8_t *out) {
+  const uint8_t *in = image.data;
+  const uint8_t *end = in + image.packed;
+  int p = 0, column = 0;
+  int pos = 0;
+  while (in < end) {
+    uint8_t c = *in++;
+    int n = c < 0x80 ? c + 1 : c - 0x7e;
+    bool literal = c < 0x80;
+    uint8_t value = literal ? 0 : *in++;
+    if (!literal && value == 0 && !out) {
+      // empty run: nothing to OR, just move on
+      column += n;
+      p += column / image.width;
+      column %= image.width;
+      continue;
+    }
+    for (int i = 0; i < n; i++) {
+      uint8_t v = literal ? *in++ : value;
+      if (out) out[pos++] = v;
+      else blitByte(*b, p, column, v);
+      if (++column == image.width) {
+        column = 0;
+        p++;
+      }
+    }
+  }
+}
+
+static const uint8_t *cached(const TileImage &image) {
+  cacheClock++;
+  CacheSlot *victim = &cache[0];
+  for (int i = 0; i < TILE_CACHE_SLOTS; i++) {
+    if (cache[i].image == &image) {
+      cache[i].used = cacheClock;
+      cacheHits++;
+      return cache[i].pages;
+    }
+    if (cache[i].used < victim->used) victim = &cache[i];
+  }
+
+  cacheMisses++;
+  victim->image = &image;
+  victim->used = cacheClock;
+  unpackTo(image, nullptr, victim->pages);
+  return victim->pages;
+}
+
+void tileDraw(const TileImage &image, int x, int y) {
+#if !TILE_BLIT
+  u8g2.drawXBMP(x, y, image.width, image.height, image.xbm);
+#else
+  Blit b;
+  if (!blitSetup(b, image, x, y)) return;
+  int pages = (image.height + 7) / 8;
+
+  if (!image.packed) {
+    blitPages(b, image.data, image.width, pages);
+  } else if (image.width * pages <= TILE_CACHE_BYTES) {
+    blitPages(b, cached(image), image.width, pages);
+  } else {
+    DIAG_SCOPE("tile decode");
+    unpackTo(image, &b, nullptr);
+  }
+#endif
+}
+
+void tileDump() {
+  Serial.printf("tiles: cache %u hits, %u misses, %d slots of %d B\n",
+                (unsigned)cacheHits, (unsigned)cacheMisses, TILE_CACHE_SLOTS, TILE_CACHE_BYTES);
+}
@@ -0,0 +1,57 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+#ifndef tiles_H
+#define tiles_H
+
+#include <stdint.h>
+
+// Bitmaps pre-converted to the SSD1306 page layout.
+//
+// u8g2's full buffer for the SSD1306 is 8 pages of 128 bytes, each byte a
+// vertical strip of 8 pixels with the LSB on top. drawXBMP() tests every
+// pixel of a row-major XBM; a TileImage is stored in the buffer's own layout
+// (pages of `width` column bytes), so tileDraw() ORs whole bytes: one OR per
+// column byte when y is a multiple of 8, two shifted ORs otherwise.
+//
+// tools/xbm2tiles.py generates icon_tiles.h/.cpp from icon.h before every
+// build and run-length codes the page bytes where that is smaller (all the
+// full-screen images; about a fifth of the XBM size over the whole set).
+// Packed images are decoded straight into the buffer on every draw, runs of
+// empty bytes are skipped without touching it. Small images (the menu icons)
+// are decoded once into a RAM cache instead and drawn from there.
+//
+// Drawing is transparent, like drawXBMP() with the bitmap mode set to 1 in
+// setup(). TILE_BLIT=0 (build_flags) draws through drawXBMP() and links the
+// XBM arrays, to compare the two with the "menu render" and "tile decode"
+// diagnostics probes.
+#ifndef TILE_BLIT
+#define TILE_BLIT 1
+#endif
+
+#if TILE_BLIT
+#define TILE_XBM(xbm) nullptr
+#else
+#define TILE_XBM(xbm) xbm
+#endif
+
+#define TILE_CACHE_SLOTS  8     // one screen's worth of menu icons
+#define TILE_CACHE_BYTES  32    // a 16x16 image
+
+struct TileImage {
+  uint8_t width;
+  uint8_t height;
+  uint16_t packed;            // run-length coded size, 0 when data holds the raw pages
+  const uint8_t *data;        // (height + 7) / 8 pages of width bytes, unused bits clear
+  const unsigned char *xbm;   // the source bitmap, only with TILE_BLIT=0
+};
+
+// Clipped to the display; x and y may be negative
+void tileDraw(const TileImage &image, int x, int y);
+
+// Serial "tiles": cache hits and misses
+void tileDump();
+
+#endif
@@ -3,6 +3,7 @@
 #include <WiFi.h>
 #include "wifideauth.h"
 #include "esp_wifi.h"
+#include "app.h"
 
 // Shared display
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
@@ -13,8 +14,7 @@ extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
 // Deauth state
 static bool deauthActive = false;
-static unsigned long lastToggle = 0;
-static const unsigned long toggleDebounce = 200;
+static bool scanning = false;           // AP scan still running in the background
 
 // Exit handling
 static bool entryPhase = true;        // true until first SELECT release
@@ -56,9 +56,8 @@ static void sendFrame(const uint8_t bssid[6], int ch) {
     esp_wifi_80211_tx(WIFI_IF_AP, deauth_frame, sizeof(deauth_frame), false);
   }
 }
-static void scanAPs() {
-  int n = WiFi.scanNetworks(false,true);
-  ap_count = n>MAX_APS?MAX_APS:n;
+static void collectAPs(int n) {
+  ap_count = n<0?0:(n>MAX_APS?MAX_APS:n);
   for(int i=0;i<ap_count;i++){
     memcpy(ap_list[i].bssid, WiFi.BSSID(i),6);
     ap_list[i].channel = WiFi.channel(i);
@@ -77,7 +76,6 @@ static void deauthAll() {
 // Public API
 void wifiDeauthSetup(){
   WiFi.mode(WIFI_AP);
-  delay(500);
 
   // show loading
   u8g2.clearBuffer();
@@ -87,24 +85,41 @@ void wifiDeauthSetup(){
   u8g2.drawStr((128-w)/2,32,msg);
   u8g2.sendBuffer();
 
-  scanAPs();
+  ap_count=0;
+  WiFi.scanNetworks(true,true);
+  scanning=true;
   deauthActive=false;
   entryPhase=true;
   selectStart=0;
+}
 
-  // show ready prompt
-  u8g2.clearBuffer();
-  u8g2.drawStr(20,20,"WiFi Deauth Ready");
-  u8g2.drawStr(15,40,"UP:toggle  SEL:exit");
-  u8g2.sendBuffer();
+void wifiDeauthStop(){
+  deauthActive=false;
+  scanning=false;
+  WiFi.scanDelete();
 }
 
-bool wifiDeauthLoop(){
+void wifiDeauthLoop(){
   unsigned long now=millis();
+
+  // wait for the AP scan without blocking the frame
+  if(scanning){
+    int n=WiFi.scanComplete();
+    if(n==WIFI_SCAN_RUNNING) return;
+    scanning=false;
+    collectAPs(n);
+
+    // show ready prompt
+    u8g2.clearBuffer();
+    u8g2.drawStr(20,20,"WiFi Deauth Ready");
+    u8g2.drawStr(15,40,"UP:toggle  SEL:exit");
+    u8g2.sendBuffer();
+    return;
+  }
+
   // toggle deauth on UP
-  if(digitalRead(BUTTON_TOGGLE_PIN)==LOW && now-lastToggle>toggleDebounce){
+  if(appPressed(BUTTON_TOGGLE_PIN)){
     deauthActive=!deauthActive;
-    lastToggle=now;
   }
 
   // display and action
@@ -119,7 +134,7 @@ bool wifiDeauthLoop(){
   u8g2.sendBuffer();
 
   // exit handling inside module
-  bool sel=(digitalRead(BUTTON_SELECT_PIN)==LOW);
+  bool sel=appHeld(BUTTON_SELECT_PIN);
   if(entryPhase){
     if(!sel){
       entryPhase=false; // initial SELECT release swallowed
@@ -129,13 +144,10 @@ bool wifiDeauthLoop(){
       if(selectStart==0) selectStart=now;
       else if(now-selectStart>exitHold){
         selectStart=0;
-        return true; 
+        appExit();
       }
     } else {
       selectStart=0;
     }
   }
-
-  delay(10);
-  return false;
 }
@@ -7,7 +7,10 @@
 void wifiDeauthSetup();
 
 // Run one iteration of deauth logic & UI.
-// Returns true if SELECT press should exit to menu.
-bool wifiDeauthLoop();
+// Holding SELECT exits to the menu via appExit().
+void wifiDeauthLoop();
+
+// Stop deauth and drop the scan results
+void wifiDeauthStop();
 
 #endif // WIFIDEAUTH_H
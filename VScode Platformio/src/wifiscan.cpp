@@ -5,6 +5,11 @@
 
 #include <Arduino.h> 
 #include "wifiscan.h"
+#include "scanlog.h"
+#include "app.h"
+#include "fmt.h"
+#include "listview.h"
+#include "esp_wifi.h"
 
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
@@ -13,15 +18,44 @@ extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 #define BTN_PIN_SELECT 27
 #define BTN_PIN_BACK 25
 
-int currentIndex = 0;
-int listStartIndex = 0;
+#define WIFI_LIST_MAX 256
+
+static uint16_t listOrder[WIFI_LIST_MAX];
+static ListView list;
 bool isDetailView = false;
 unsigned long scan_StartTime = 0;
 const unsigned long scanTimeout = 5000;
 bool isScanComplete = false;
 
-unsigned long lastButtonPress = 0;
-unsigned long debounceTime = 200;
+// WiFi.SSID() and friends return Arduino Strings; the raw scan records are
+// read in place instead so drawing never allocates
+static const wifi_ap_record_t *scanRecord(int index) {
+  return (const wifi_ap_record_t *)WiFi.getScanInfoByIndex(index);
+}
+
+static int listCountFn() {
+  int n = WiFi.scanComplete();
+  return n > 0 ? n : 0;
+}
+
+static void listRowFn(int index, char *out, size_t size) {
+  const wifi_ap_record_t *ap = scanRecord(index);
+  if (ap) fmtScanRow(out, size, (const char *)ap->ssid, ap->rssi);
+  else out[0] = '\0';
+}
+
+static uint32_t listKeyFn(int index, uint8_t sort) {
+  const wifi_ap_record_t *ap = scanRecord(index);
+  if (!ap) return UINT32_MAX;
+  return sort == LIST_SORT_RSSI ? listRssiKey(ap->rssi) : listNameKey((const char *)ap->ssid);
+}
+
+// The scan runs in the background; the list is drawn once it completes
+static void startScan() {
+  WiFi.scanNetworks(true);
+  scan_StartTime = millis();
+  isScanComplete = false;
+}
 
 void wifiscanSetup() {
   Serial.begin(115200);
@@ -30,117 +64,88 @@ void wifiscanSetup() {
   WiFi.mode(WIFI_STA);
   WiFi.disconnect();
   
-  pinMode(BTN_PIN_UP, INPUT_PULLUP);
-  pinMode(BTN_PIN_DOWN, INPUT_PULLUP);
-  pinMode(BTN_PIN_SELECT, INPUT_PULLUP);
-  pinMode(BTN_PIN_BACK, INPUT_PULLUP);
-  
-  for (int cycle = 0; cycle < 3; cycle++) { 
-    for (int i = 0; i < 3; i++) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_ncenB08_tr);
-      u8g2.drawStr(0, 10, "Scanning WiFi");
-
-      String dots = "";
-      for (int j = 0; j <= i; j++) {
-        dots += " .";
-      }
-      
-      u8g2.drawStr(80, 10, dots.c_str()); 
+  listInit(list, listCountFn, listRowFn, listKeyFn, (1 << LIST_SORT_RSSI) | (1 << LIST_SORT_NAME),
+           listOrder, WIFI_LIST_MAX);
+  isDetailView = false;
+  startScan();
+}
 
-      u8g2.sendBuffer();
-      delay(300); 
-    }
-  }
-  
-  scan_StartTime = millis();
-  isScanComplete = false;
+void wifiscanStop() {
+  WiFi.scanDelete();
 }
 
 void wifiscanLoop() {
   unsigned long currentMillis = millis();
 
-  if (!isScanComplete && currentMillis - scan_StartTime < scanTimeout) {
-    int foundNetworks = WiFi.scanNetworks();
+  if (!isScanComplete) {
+    static const char *const dots[] = { " .", " . .", " . . ." };
+    int foundNetworks = WiFi.scanComplete();
+
     if (foundNetworks >= 0) {
       isScanComplete = true;
+      for (int i = 0; i < foundNetworks; i++) {
+        scanlogWifi(WiFi.BSSID(i), WiFi.RSSI(i), WiFi.channel(i), WiFi.encryptionType(i));
+      }
+    } else if (foundNetworks == WIFI_SCAN_FAILED) {
+      // retry until the timeout, then show the (empty) list
+      if (currentMillis - scan_StartTime < scanTimeout) WiFi.scanNetworks(true);
+      else isScanComplete = true;
     }
-  }
 
-  if (currentMillis - lastButtonPress > debounceTime) {
-    if (digitalRead(BTN_PIN_UP) == LOW) {
-      if (currentIndex > 0) {
-        currentIndex--;
-        if (currentIndex < listStartIndex) {
-          listStartIndex--;
-        }
-      }
-      lastButtonPress = currentMillis;
-    } else if (digitalRead(BTN_PIN_DOWN) == LOW) {
-      if (currentIndex < WiFi.scanComplete() - 1) {
-        currentIndex++;
-        if (currentIndex >= listStartIndex + 5) {
-          listStartIndex++;
-        }
-      }
-      lastButtonPress = currentMillis;
-    } else if (digitalRead(BTN_PIN_SELECT) == LOW) {
-      isDetailView = true;
-      lastButtonPress = currentMillis;
+    if (!isScanComplete) {
+      u8g2.clearBuffer();
+      u8g2.setFont(u8g2_font_ncenB08_tr);
+      u8g2.drawStr(0, 10, "Scanning WiFi");
+      u8g2.drawStr(80, 10, dots[(currentMillis / 300) % 3]);
+      u8g2.sendBuffer();
+      return;
     }
+
+    // results are in, draw the list
+    appInvalidate();
   }
 
-  if (!isDetailView && isScanComplete) {
+  if (!isDetailView) {
+    // the results do not change after the scan; only input and sorting redraw
+    if (listUpdate(list)) appInvalidate();
+    if (appPressed(BTN_PIN_SELECT) && listCount(list) > 0) isDetailView = true;
+  }
+
+  bool redraw = appRedraw();
+
+  if (!isDetailView && redraw) {
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_6x10_tr);
     u8g2.drawStr(0, 10, "Wi-Fi Networks:");
-
-    int networkCount = WiFi.scanComplete();
-    for (int i = 0; i < 5; i++) {
-      int currentNetworkIndex = i + listStartIndex;
-      if (currentNetworkIndex >= networkCount) break;
-
-      String networkName = WiFi.SSID(currentNetworkIndex);
-      int rssi = WiFi.RSSI(currentNetworkIndex);
-
-      String networkInfo = networkName.substring(0, 7);
-      String networkrssi = " | RSSI " + String(rssi);
-
-      if (currentNetworkIndex == currentIndex) {
-        u8g2.drawStr(0, 20 + i * 10, ">");
-      }
-      u8g2.drawStr(10, 20 + i * 10, networkInfo.c_str());
-      u8g2.drawStr(50, 20 + i * 10, networkrssi.c_str());
-    }
+    listDraw(list, 20);
     u8g2.sendBuffer();
   }
 
-  if (isDetailView) {
-    String networkName = WiFi.SSID(currentIndex);
-    String networkBSSID = WiFi.BSSIDstr(currentIndex);
-    int rssi = WiFi.RSSI(currentIndex);
-    int channel = WiFi.channel(currentIndex);
+  const wifi_ap_record_t *ap = isDetailView ? scanRecord(listSelected(list)) : nullptr;
+  if (ap && redraw) {
+    char mac[FMT_MAC_LEN];
+    char line[FMT_LINE];
+    fmtMac(mac, sizeof(mac), ap->bssid);
 
     u8g2.clearBuffer();
     u8g2.setFont(u8g2_font_6x10_tr);
     u8g2.drawStr(0, 10, "Network Details:");
 
     u8g2.setFont(u8g2_font_5x8_tr);
-    String name = "SSID: " + networkName;
-    String bssid = "BSSID: " + networkBSSID;
-    String signal = "RSSI: " + String(rssi);
-    String ch = "Channel: " + String(channel);
-
-    u8g2.drawStr(0, 20, name.c_str());
-    u8g2.drawStr(0, 30, bssid.c_str());
-    u8g2.drawStr(0, 40, signal.c_str());
-    u8g2.drawStr(0, 50, ch.c_str());
+    fmt(line, sizeof(line), "SSID: %.32s", (const char *)ap->ssid);
+    u8g2.drawStr(0, 20, line);
+    fmt(line, sizeof(line), "BSSID: %s", mac);
+    u8g2.drawStr(0, 30, line);
+    fmt(line, sizeof(line), "RSSI: %d", ap->rssi);
+    u8g2.drawStr(0, 40, line);
+    fmt(line, sizeof(line), "Channel: %d", ap->primary);
+    u8g2.drawStr(0, 50, line);
     u8g2.drawStr(0, 60, "Press LEFT to go back");
     u8g2.sendBuffer();
+  }
 
-    if (digitalRead(BTN_PIN_BACK) == LOW) {
-      isDetailView = false;
-      lastButtonPress = currentMillis;
-    }
+  if (isDetailView && appPressed(BTN_PIN_BACK)) {
+    isDetailView = false;
+    appInvalidate();    // this frame's redraw went to the detail view
   }
 }
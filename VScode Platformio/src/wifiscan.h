@@ -11,5 +11,6 @@
 
 void wifiscanSetup();
 void wifiscanLoop();
+void wifiscanStop();
 
 #endif
@@ -0,0 +1,247 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+// The BLE counter's HyperLogLog sketch (src/hll.h) on a PC, against exact
+// counts kept in a std::set, on synthetic advertisement streams.
+//
+//   g++ -O2 -I../src -o hllbench hllbench.cpp
+//   ./hllbench [trials] [seed]
+//
+// Cardinality: n devices, each advertising 1 to 20 times in shuffled order,
+// into one sketch. Windows: a population of devices, each with a vendor and
+// an address type, over 12 slots kept in a ring of 8 with a sketch per slot
+// and per count as in blecount.cpp. Public and static addresses stay put,
+// resolvable private addresses move to a new random value with chance 1/4
+// per slot and non-resolvable ones every slot. The union of the last 4 and 8
+// slots (hllMerge) and the session sketch are compared, for every count, to
+// the set of addresses seen in them.
+//
+// Both print the rms relative error. For 128 registers it should come out
+// near 1.04 / sqrt(128) = 9.2 %, a little lower while linear counting covers
+// the small counts, with a bump around 2.5 x 128 where it hands over to the
+// harmonic mean. Any rms error over twice that (18.4 %) fails the run with
+// exit status 1; with fewer trials than the default the rms itself gets
+// noisy, so the bound is only checked from 100 trials up.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+#include "hll.h"
+
+#define SLOTS       8     // ring, as SLOT_COUNT in blecount.cpp
+#define SIM_SLOTS   12    // slots simulated, so the session outlasts the ring
+#define MIN_TRIALS  100   // fewest trials the bound is checked at
+
+static const double limit = 2 * 1.04 / sqrt((double)HLL_M) * 100;
+static bool checked = true;
+static int failures = 0;
+
+// The counts blecount.cpp keeps, in its KIND_ order
+enum Kind { TOTAL, APPLE, MICROSOFT, SAMSUNG, GOOGLE, OTHER, PUBLIC, STATIC, RPA, NRPA, KINDS };
+static const char *const kindNames[KINDS] = {
+  "total", "apple", "msft", "samsung", "google", "other", "public", "static", "rpa", "nrpa",
+};
+
+static uint64_t rng = 1;
+
+static uint64_t next() {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+// 48 random address bits, as hllHashAddr() sees them
+static uint64_t randomAddr() {
+  return next() & 0xFFFFFFFFFFFFULL;
+}
+
+// Random addresses carry their sub-type in the two top bits
+static uint64_t addrOfKind(int kind) {
+  uint64_t a = randomAddr() & 0x3FFFFFFFFFFFULL;
+  if (kind == STATIC) return a | 0xC00000000000ULL;
+  if (kind == RPA) return a | 0x400000000000ULL;
+  if (kind == NRPA) return a;
+  return randomAddr();
+}
+
+// Shares in percent, roughly what a busy room shows
+static int pick(const int *shares, int first, int count) {
+  int r = next() % 100;
+  for (int i = 0; i < count - 1; i++) {
+    if (r < shares[i]) return first + i;
+    r -= shares[i];
+  }
+  return first + count - 1;
+}
+
+static void addAddr(HllSketch &s, uint64_t addr) {
+  uint8_t bda[6];
+  for (int i = 0; i < 6; i++) bda[i] = (uint8_t)(addr >> (40 - 8 * i));
+  hllAdd(s, hllHashAddr(bda));
+}
+
+struct Error {
+  double sumSq = 0;
+  double worst = 0;
+  int n = 0;
+
+  void add(double estimate, double exact) {
+    if (exact == 0) return;
+    double e = (estimate - exact) / exact;
+    sumSq += e * e;
+    worst = std::max(worst, fabs(e));
+    n++;
+  }
+  double rms() const { return n ? sqrt(sumSq / n) * 100 : 0; }
+
+  // false (and counted) when over the bound
+  bool ok() {
+    if (!checked || rms() <= limit) return true;
+    failures++;
+    return false;
+  }
+};
+
+static void cardinality(int trials) {
+  static const int sizes[] = { 10, 30, 100, 300, 1000, 3000, 10000, 30000 };
+  printf("devices  adverts/trial  rms error  worst\n");
+  for (int n : sizes) {
+    Error err;
+    long adverts = 0;
+    for (int t = 0; t < trials; t++) {
+      std::vector<uint64_t> stream;
+      for (int d = 0; d < n; d++) {
+        uint64_t addr = randomAddr();
+        int repeats = 1 + next() % 20;
+        for (int r = 0; r < repeats; r++) stream.push_back(addr);
+      }
+      for (size_t i = stream.size() - 1; i > 0; i--) std::swap(stream[i], stream[next() % (i + 1)]);
+
+      HllSketch s;
+      hllClear(s);
+      std::set<uint64_t> exact;
+      for (uint64_t addr : stream) {
+        addAddr(s, addr);
+        exact.insert(addr);
+      }
+      err.add(hllEstimate(s), exact.size());
+      adverts += stream.size();
+    }
+    printf("%7d %14ld %9.1f%% %5.1f%%%s\n", n, adverts / trials, err.rms(), err.worst * 100,
+           err.ok() ? "" : "  over the bound");
+  }
+}
+
+struct Device {
+  uint64_t addr;
+  uint8_t vendor;
+  uint8_t type;
+};
+
+static void windows(int trials) {
+  static const int populations[] = { 20, 100, 500, 2000 };
+  static const int vendorShares[] = { 40, 10, 15, 10 };          // apple .. google, rest other
+  static const int typeShares[] = { 20, 15, 50 };                // public, static, rpa, rest nrpa
+  static const char *const windowNames[] = { "1 min", "2 min", "all" };
+  static const int windowSlots[] = { 4, SLOTS, 0 };
+
+  printf("\nrms error %%, by count");
+  printf("\ndevices window");
+  for (int k = 0; k < KINDS; k++) printf(" %7s", kindNames[k]);
+  printf("\n");
+
+  for (int population : populations) {
+    Error err[3][KINDS];
+    for (int t = 0; t < trials; t++) {
+      std::vector<Device> devices(population);
+      for (auto &d : devices) {
+        d.vendor = pick(vendorShares, APPLE, OTHER - APPLE + 1);
+        d.type = pick(typeShares, PUBLIC, NRPA - PUBLIC + 1);
+        d.addr = addrOfKind(d.type);
+      }
+
+      HllSketch slots[SLOTS][KINDS], session[KINDS];
+      std::set<uint64_t> seen[SLOTS][KINDS], seenSession[KINDS];
+      for (int k = 0; k < KINDS; k++) hllClear(session[k]);
+
+      for (int slot = 0; slot < SIM_SLOTS; slot++) {
+        int ring = slot % SLOTS;
+        for (int k = 0; k < KINDS; k++) {
+          hllClear(slots[ring][k]);
+          seen[ring][k].clear();
+        }
+        for (auto &d : devices) {
+          if ((d.type == RPA && next() % 4 == 0) || d.type == NRPA) d.addr = addrOfKind(d.type);
+          int kinds[3] = { TOTAL, d.vendor, d.type };
+          for (int k : kinds) {
+            // three adverts each: repeats must not count
+            for (int advert = 0; advert < 3; advert++) {
+              addAddr(slots[ring][k], d.addr);
+              addAddr(session[k], d.addr);
+            }
+            seen[ring][k].insert(d.addr);
+            seenSession[k].insert(d.addr);
+          }
+        }
+      }
+
+      // the ring holds the last SLOTS slots, newest at (SIM_SLOTS - 1) % SLOTS
+      for (int w = 0; w < 3; w++) {
+        for (int k = 0; k < KINDS; k++) {
+          if (windowSlots[w] == 0) {
+            err[w][k].add(hllEstimate(session[k]), seenSession[k].size());
+            continue;
+          }
+          HllSketch merged;
+          hllClear(merged);
+          std::set<uint64_t> exact;
+          for (int back = 0; back < windowSlots[w]; back++) {
+            int ring = (SIM_SLOTS - 1 - back) % SLOTS;
+            hllMerge(merged, slots[ring][k]);
+            exact.insert(seen[ring][k].begin(), seen[ring][k].end());
+          }
+          err[w][k].add(hllEstimate(merged), exact.size());
+        }
+      }
+    }
+
+    for (int w = 0; w < 3; w++) {
+      printf("%7d %6s", population, windowNames[w]);
+      for (int k = 0; k < KINDS; k++) {
+        bool ok = err[w][k].ok();
+        printf(" %6.1f%c", err[w][k].rms(), ok ? ' ' : '!');
+      }
+      printf("\n");
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  int trials = argc > 1 ? atoi(argv[1]) : 200;
+  rng = argc > 2 ? strtoull(argv[2], nullptr, 0) : 1;
+  if (trials < 1 || rng == 0) {
+    fprintf(stderr, "usage: hllbench [trials] [seed != 0]\n");
+    return 2;
+  }
+  checked = trials >= MIN_TRIALS;
+  printf("%d registers, %d B per sketch, %d trials\n\n", HLL_M, HLL_BYTES, trials);
+  cardinality(trials);
+  windows(trials);
+
+  if (!checked) {
+    printf("\nfewer than %d trials, rms bound of %.1f%% not checked\n", MIN_TRIALS, limit);
+    return 0;
+  }
+  if (failures) {
+    printf("\n%d rms errors over the bound of %.1f%% (marked !)\n", failures, limit);
+    return 1;
+  }
+  printf("\nall rms errors within %.1f%%\n", limit);
+  return 0;
+}
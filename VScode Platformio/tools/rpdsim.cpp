@@ -0,0 +1,124 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+// Simulated RPD sweeps on a PC: how well rpdEstimate() (src/rpdlevel.cpp)
+// recovers a channel's power for a given number of steps and passes, and
+// what the sweep costs on the radio.
+//
+//   g++ -O2 -I../src -o rpdsim rpdsim.cpp ../src/rpdlevel.cpp
+//   ./rpdsim [trials] [calibration error dB]
+//
+// Each simulated channel is busy for a fraction `duty` of the listens, and
+// while busy its power is P plus a normal variation of 4 dB. A listen at step
+// k fires when that power reaches the step's true threshold, which is the
+// calibration table plus the given error (default 0) for every step but the
+// first. The passes are spread round robin over the first `steps` steps, as
+// the analyzer does. Errors are taken for duty 0.1 to 1 and P in three
+// bands: below the thresholds, between them and above them. A channel left
+// at RPD_QUIET counts as -76 dBm.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "rpdlevel.h"
+
+#define LISTEN_US   128     // CE high per channel, as in the analyzer
+#define SPI_US      12      // RF_CH write and RPD read per channel
+#define SETUP_US    6       // RF_SETUP write once per pass
+#define CHANNELS    128
+#define LOW_DBM     (-76)
+#define HIGH_DBM    (-40)
+
+static uint32_t rng = 0x12345678;
+
+static double uniform() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng + 0.5) / 4294967296.0;
+}
+
+static double normal() {
+  return sqrt(-2 * log(uniform())) * cos(2 * M_PI * uniform());
+}
+
+#define BANDS 3
+static const int bandTop[BANDS] = { -66, -52, HIGH_DBM };
+
+struct Result {
+  double rms[BANDS];
+  double within3;         // share of all estimates within 3 dB
+};
+
+static Result run(int steps, int passes, int trials, double calError) {
+  static const double duties[] = { 0.1, 0.3, 1.0 };
+  double sumSq[BANDS] = {};
+  long n[BANDS] = {}, all = 0, close = 0;
+
+  for (int p = LOW_DBM; p <= HIGH_DBM; p += 2) {
+    int band = 0;
+    while (p > bandTop[band]) band++;
+    for (double duty : duties) {
+      for (int t = 0; t < trials; t++) {
+        uint8_t hits[RPD_STEPS] = {}, samples[RPD_STEPS] = {};
+        for (int pass = 0; pass < passes; pass++) {
+          int k = pass % steps;
+          double threshold = rpdThreshold(k) / 10.0 + (k ? calError : 0);
+          samples[k]++;
+          if (uniform() < duty && p + rpdSpread / 10.0 * normal() >= threshold) hits[k]++;
+        }
+        int est = rpdEstimate(hits, samples);
+        if (est == RPD_QUIET || est < LOW_DBM) est = LOW_DBM;
+        double err = est - p;
+        sumSq[band] += err * err;
+        n[band]++;
+        if (fabs(err) <= 3) close++;
+        all++;
+      }
+    }
+  }
+  Result r;
+  for (int b = 0; b < BANDS; b++) r.rms[b] = sqrt(sumSq[b] / n[b]);
+  r.within3 = (double)close / all;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  int trials = argc > 1 ? atoi(argv[1]) : 200;
+  double calError = argc > 2 ? atof(argv[2]) : 0;
+  static const int passList[] = { 12, 24, 48, 96, 192 };
+
+  printf("thresholds");
+  for (int k = 0; k < RPD_STEPS; k++) printf("  %s %.1f", rpdSteps[k].name, rpdThreshold(k) / 10.0);
+  printf(" dBm, spread %.1f dB, calibration error %+.1f dB\n\n", rpdSpread / 10.0, calError);
+
+  printf("                                  rms error dB\n");
+  printf("steps passes  sweep ms  overhead  <=%d  <=%d  <=%d  within 3 dB\n",
+         bandTop[0], bandTop[1], bandTop[2]);
+  for (int steps = 1; steps <= RPD_STEPS; steps++) {
+    for (int passes : passList) {
+      double sweepUs = (double)passes * CHANNELS * (LISTEN_US + SPI_US);
+      double setupUs = steps > 1 ? passes * SETUP_US : 0;
+      Result r = run(steps, passes, trials, calError);
+      printf("%5d %6d %9.0f %8.2f%% %5.1f %5.1f %5.1f %11.0f%%\n", steps, passes,
+             (sweepUs + setupUs) / 1000, setupUs * 100 / sweepUs, r.rms[0], r.rms[1], r.rms[2],
+             r.within3 * 100);
+    }
+  }
+
+  // the estimate itself, per channel and sweep
+  uint8_t hits[RPD_STEPS] = { 20, 12, 3 }, samples[RPD_STEPS] = { 32, 32, 32 };
+  volatile int sink = 0;
+  const int reps = 200000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) {
+    hits[i & 3] ^= 1;
+    sink += rpdEstimate(hits, samples);
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reps;
+  printf("\nrpdEstimate %.0f ns per channel on this machine\n", ns);
+  return 0;
+}
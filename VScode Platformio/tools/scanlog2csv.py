@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Convert an nRF-BOX scan log to CSV.
+
+Input is either the raw /scanlog.bin pulled off the SPIFFS partition, or a
+serial capture of the "log dump" command (hex pages between the
+#SCANLOG BEGIN / #SCANLOG END markers). Pages with a bad magic or CRC are
+skipped and counted on stderr. A power loss in the middle of an append can
+leave a partial page that shifts everything after it, so past a bad page
+the reader looks for the next magic rather than stepping a whole page.
+
+    python scanlog2csv.py capture.txt > scanlog.csv
+"""
+
+import csv
+import struct
+import sys
+import zlib
+
+PAGE_SIZE = 256
+PAGE_RECORDS = 15
+MAGIC = 0x4C53
+
+HEADER = struct.Struct("<HHIB3x")
+RECORD = struct.Struct("<IBbBBH6s")
+
+KINDS = {1: "wifi", 2: "ble", 3: "sentinel"}
+WIFI_AUTH = ["open", "wep", "wpa", "wpa2", "wpa/wpa2", "wpa2-ent", "wpa3", "wpa2/wpa3", "wapi"]
+BLE_ADDR_TYPE = ["public", "random", "rpa-public", "rpa-random"]
+
+
+def page_ok(page):
+    magic, session, seq, count = HEADER.unpack_from(page)
+    crc, = struct.unpack_from("<I", page, PAGE_SIZE - 4)
+    return magic == MAGIC and count <= PAGE_RECORDS and crc == zlib.crc32(page[:-4])
+
+
+def read_pages(data):
+    """Intact pages in file order, and the number of damaged stretches skipped."""
+    if b"#SCANLOG BEGIN" in data:
+        pages = bytearray()
+        inside = False
+        for line in data.splitlines():
+            line = line.strip()
+            if line == b"#SCANLOG BEGIN":
+                inside = True
+            elif line == b"#SCANLOG END":
+                inside = False
+            elif inside and len(line) == 2 * PAGE_SIZE:
+                try:
+                    pages += bytes.fromhex(line.decode("ascii"))
+                except ValueError:
+                    pass
+        data = bytes(pages)
+
+    good = []
+    bad = 0
+    damaged = False
+    magic = struct.pack("<H", MAGIC)
+    off = 0
+    while off + PAGE_SIZE <= len(data):
+        page = data[off:off + PAGE_SIZE]
+        if page_ok(page):
+            good.append(page)
+            off += PAGE_SIZE
+            damaged = False
+            continue
+        if not damaged:
+            bad += 1
+            damaged = True
+        off = data.find(magic, off + 1)
+        if off < 0:
+            break
+    if 0 <= off < len(data) and not damaged:
+        bad += 1        # partial page at the end
+    return good, bad
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: scanlog2csv.py <scanlog.bin | serial capture>")
+
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+
+    out = csv.writer(sys.stdout)
+    out.writerow(["session", "page", "time_ms", "kind", "address", "rssi",
+                  "channel_or_addr_type", "auth", "vendor"])
+
+    pages, bad = read_pages(data)
+    for page in pages:
+        magic, session, seq, count = HEADER.unpack_from(page)
+        for i in range(count):
+            t, kind, rssi, chan, flags, vendor, addr = RECORD.unpack_from(page, HEADER.size + i * RECORD.size)
+            address = ":".join("%02x" % b for b in addr)
+            if kind == 1:
+                where = chan
+                auth = WIFI_AUTH[flags] if flags < len(WIFI_AUTH) else flags
+                company = ""
+            elif kind == 3:
+                # alert: worst band's first channel, bands over baseline, excess hits
+                address = ""
+                where = chan
+                auth = flags
+                company = vendor
+            else:
+                where = BLE_ADDR_TYPE[chan] if chan < len(BLE_ADDR_TYPE) else chan
+                auth = ""
+                company = "" if vendor == 0xFFFF else "0x%04x" % vendor
+            out.writerow([session, seq, t, KINDS.get(kind, kind), address, rssi, where, auth, company])
+
+    print("%d pages ok, %d damaged stretches skipped" % (len(pages), bad), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
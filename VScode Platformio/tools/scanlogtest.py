@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Host check of scanlog2csv.read_pages() on damaged logs.
+
+Builds scan log pages the way src/scanlog.cpp lays them out, tears them as a
+power loss would, and checks that every intact page is still read back, in
+order, with the damage counted. Exits non-zero on the first case that fails.
+
+    python scanlogtest.py
+"""
+
+import struct
+import sys
+import zlib
+
+import scanlog2csv as sl
+
+
+def page(session, seq, count=sl.PAGE_RECORDS):
+    body = sl.HEADER.pack(sl.MAGIC, session, seq, count)
+    for i in range(sl.PAGE_RECORDS):
+        if i < count:
+            # BSSID bytes that contain the magic, so a resync has false hits to reject
+            body += sl.RECORD.pack(1000 * seq + i, 1, -60, 6, 3, 0xFFFF, b"\x53\x4c" + bytes([seq, i, 0, 0]))
+        else:
+            body += bytes(sl.RECORD.size)
+    return body + struct.pack("<I", zlib.crc32(body))
+
+
+def batch(session, first, pages):
+    return b"".join(page(session, first + i) for i in range(pages))
+
+
+def seqs(pages):
+    return [sl.HEADER.unpack_from(p)[2] for p in pages]
+
+
+def dump(data):
+    """A "log dump" capture: the device prints intact pages only, one per line."""
+    lines = [b"boot noise", b"#SCANLOG BEGIN"]
+    lines += [p.hex().encode("ascii") for p in sl.read_pages(data)[0]]
+    lines += [b"#SCANLOG END", b"ok"]
+    return b"\r\n".join(lines)
+
+
+def main():
+    head = batch(1, 0, 4)
+    tail = batch(1, 4, 4)
+    next_boot = batch(2, 0, 2)
+    torn = batch(1, 4, 4)[:300]        # one page and a bit of the next made it
+    pad = b"\xff" * (sl.PAGE_SIZE - len(torn) % sl.PAGE_SIZE)
+
+    cases = [
+        # name, file contents, pages expected (session, seq), damaged stretches
+        ("clean", head + tail, [0, 1, 2, 3, 4, 5, 6, 7], 0),
+        ("truncated", head + tail[:-100], [0, 1, 2, 3, 4, 5, 6], 1),
+        ("torn tail", head + torn, [0, 1, 2, 3, 4], 1),
+        # older firmware: appended straight after the tear, off the page grid
+        ("torn, appended after", head + torn + next_boot, [0, 1, 2, 3, 4, 0, 1], 1),
+        # current firmware: padded to a page boundary at mount, then appended
+        ("torn, padded", head + torn + pad + next_boot, [0, 1, 2, 3, 4, 0, 1], 1),
+        ("torn twice", head + torn + batch(2, 0, 1)[:17] + next_boot, [0, 1, 2, 3, 4, 0, 1], 1),
+        ("empty", b"", [], 0),
+        ("shorter than a page", head[:200], [], 1),
+    ]
+
+    failed = 0
+    for name, data, want, want_bad in cases:
+        for kind, raw in (("bin", data), ("dump", dump(data))):
+            got, bad = sl.read_pages(raw)
+            # a dump only carries intact pages, so it has nothing damaged left
+            expect_bad = want_bad if kind == "bin" else 0
+            ok = seqs(got) == want and bad == expect_bad
+            print("%-22s %-4s %2d pages, %d damaged  %s" % (name, kind, len(got), bad, "ok" if ok else "FAIL"))
+            if not ok:
+                print("  want pages %s, %d damaged; got %s" % (want, expect_bad, seqs(got)))
+                failed += 1
+
+    if failed:
+        print("%d cases failed" % failed)
+        sys.exit(1)
+    print("all cases ok")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,136 @@
+/* ____________________________
+   This software is licensed under the MIT License:
+   https://github.com/cifertech/nrfbox
+   ________________________________________ */
+
+// Headless Snake on a PC: times snakeStep() over seeded games and replays
+// recorded turns, for checking a change to src/snakecore.cpp against the
+// previous build.
+//
+//   g++ -O2 -I../src -o snakebench snakebench.cpp ../src/snakecore.cpp
+//   ./snakebench [games] [seed]            autopilot games, hash per game
+//   ./snakebench replay <seed> <wrap> <turns>
+//
+// Autopilot games run twice and must end in the same state. <turns> has one
+// character per step: U D L R to steer, anything else to go straight. Each
+// run prints a final hash of the board; equal hashes mean equal games.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "snakecore.h"
+
+static const char dirChars[] = "UDLR";
+
+static bool safe(const SnakeState &s, SnakeDir dir, uint16_t &cell) {
+  static const int stepX[] = { 0, 0, -1, 1 };
+  static const int stepY[] = { -1, 1, 0, 0 };
+  uint16_t head = snakeSegment(s, 0);
+  int x = snakeCellX(head) + stepX[dir];
+  int y = snakeCellY(head) + stepY[dir];
+  if (x < 0 || x >= SNAKE_COLS || y < 0 || y >= SNAKE_ROWS) {
+    if (!s.wrap) return false;
+    x = (x + SNAKE_COLS) % SNAKE_COLS;
+    y = (y + SNAKE_ROWS) % SNAKE_ROWS;
+  }
+  cell = snakeCell(x, y);
+  return !snakeOccupied(s, cell) || cell == snakeSegment(s, s.length - 1);
+}
+
+// Greedy: the safe move that gets closest to the food, else any safe move
+static char autopilot(const SnakeState &s) {
+  int best = -1, bestDist = 1 << 30;
+  for (int d = 0; d < 4; d++) {
+    uint16_t cell;
+    if ((d >> 1) == (s.dir >> 1) && d != s.dir) continue;
+    if (!safe(s, (SnakeDir)d, cell)) continue;
+    int dist = abs(snakeCellX(cell) - snakeCellX(s.food)) + abs(snakeCellY(cell) - snakeCellY(s.food));
+    if (dist < bestDist) {
+      bestDist = dist;
+      best = d;
+    }
+  }
+  return best < 0 ? '.' : dirChars[best];
+}
+
+static SnakeEvent step(SnakeState &s, char turn) {
+  const char *d = strchr(dirChars, turn);
+  if (turn && d) snakeSteer(s, (SnakeDir)(d - dirChars));
+  return snakeStep(s);
+}
+
+static const char *eventName(SnakeEvent ev) {
+  switch (ev) {
+    case SNAKE_MOVED: return "moved";
+    case SNAKE_ATE:   return "ate";
+    case SNAKE_DIED:  return "died";
+    case SNAKE_WON:   return "won";
+  }
+  return "?";
+}
+
+// One autopilot game; the turns taken are appended to turns when given
+static SnakeEvent play(SnakeState &s, uint32_t seed, bool wrap, long &steps, std::string *turns) {
+  snakeReset(s, seed, wrap);
+  SnakeEvent ev = SNAKE_MOVED;
+  for (steps = 0; steps < 200000 && ev != SNAKE_DIED && ev != SNAKE_WON; steps++) {
+    char turn = autopilot(s);
+    if (turns) turns->push_back(turn);
+    ev = step(s, turn);
+  }
+  return ev;
+}
+
+static int bench(int games, uint32_t seed) {
+  static SnakeState s;
+  long totalSteps = 0;
+  int mismatches = 0;
+  double totalNs = 0;
+
+  for (int g = 0; g < games; g++) {
+    uint32_t gameSeed = seed + g;
+    bool wrap = g & 1;
+    long steps;
+    auto start = std::chrono::steady_clock::now();
+    SnakeEvent ev = play(s, gameSeed, wrap, steps, nullptr);
+    totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    totalSteps += steps;
+    uint32_t hash = snakeHash(s);
+    int length = s.length;
+
+    long again;
+    play(s, gameSeed, wrap, again, nullptr);
+    bool same = again == steps && snakeHash(s) == hash;
+    if (!same) mismatches++;
+
+    printf("seed %u wrap %d: %s after %ld steps, length %d, hash %08x%s\n",
+           (unsigned)gameSeed, wrap, eventName(ev), steps, length, (unsigned)hash,
+           same ? "" : "  REPLAY MISMATCH");
+  }
+  printf("%ld steps, %.1f ns per step (autopilot included), %d mismatches\n",
+         totalSteps, totalSteps ? totalNs / totalSteps : 0.0, mismatches);
+  return mismatches ? 1 : 0;
+}
+
+static int replay(uint32_t seed, bool wrap, const char *turns) {
+  static SnakeState s;
+  snakeReset(s, seed, wrap);
+  SnakeEvent ev = SNAKE_MOVED;
+  long steps = 0;
+  for (; turns[steps] && ev != SNAKE_DIED && ev != SNAKE_WON; steps++) ev = step(s, turns[steps]);
+  printf("%s after %ld steps, length %d, hash %08x\n", eventName(ev), steps, s.length, (unsigned)snakeHash(s));
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 5 && strcmp(argv[1], "replay") == 0) {
+    return replay(strtoul(argv[2], nullptr, 0), atoi(argv[3]) != 0, argv[4]);
+  }
+  if (argc > 3) {
+    fprintf(stderr, "usage: snakebench [games] [seed] | snakebench replay <seed> <wrap> <turns>\n");
+    return 2;
+  }
+  return bench(argc > 1 ? atoi(argv[1]) : 20, argc > 2 ? strtoul(argv[2], nullptr, 0) : 1);
+}
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Decode a binary console stream ("stream bin") captured from the nRF-BOX.
+
+Frames are 0xA5 kind len time_ms(u32 LE) payload[len] xor, interleaved with
+text reply lines. Bytes that do not form a frame with a good xor are
+skipped, which also skips the text.
+
+    python stream2csv.py capture.bin > survey.csv
+"""
+
+import csv
+import struct
+import sys
+
+KINDS = {1: "scanner", 2: "analyzer", 3: "wifi", 4: "ble", 5: "sentinel"}
+RECORD = struct.Struct("<IBbBBH6s")
+
+
+def frames(data):
+    i = 0
+    while i + 8 <= len(data):
+        if data[i] != 0xA5:
+            i += 1
+            continue
+        kind, length = data[i + 1], data[i + 2]
+        end = i + 7 + length
+        if end >= len(data):
+            break
+        x = 0
+        for b in data[i + 1:end]:
+            x ^= b
+        if kind not in KINDS or x != data[end]:
+            i += 1
+            continue
+        ms, = struct.unpack_from("<I", data, i + 3)
+        yield kind, ms, data[i + 7:end]
+        i = end + 1
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: stream2csv.py <capture.bin>")
+
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+
+    out = csv.writer(sys.stdout)
+    out.writerow(["kind", "time_ms", "address", "rssi", "channel", "values"])
+    for kind, ms, payload in frames(data):
+        if kind == 5 and len(payload) == RECORD.size:
+            _, _, _, chan, bands, excess, _ = RECORD.unpack(payload)
+            out.writerow([KINDS[kind], ms, "", "", chan, "%d %d" % (bands, excess)])
+        elif kind in (3, 4) and len(payload) == RECORD.size:
+            _, _, rssi, chan, _, _, addr = RECORD.unpack(payload)
+            out.writerow([KINDS[kind], ms, ":".join("%02x" % b for b in addr), rssi, chan, ""])
+        else:
+            out.writerow([KINDS[kind], ms, "", "", "", " ".join(str(b) for b in payload)])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Convert the bitmaps in src/icon.h to packed SSD1306 page layout.
+
+XBM stores a bitmap row by row, 8 horizontal pixels per byte, so drawing it
+costs a pixel test per bit. The SSD1306 frame buffer (and u8g2's full
+buffer for it) is 8 pages of 128 columns with one vertical 8-pixel strip per
+byte, LSB on top. Stored the same way, a bitmap is drawn by OR-ing whole
+bytes into the buffer (tiles.h).
+
+The page bytes are then run-length coded, which mostly folds away the empty
+space around the artwork:
+
+    0x00..0x7f  n + 1 literal bytes follow
+    0x80..0xff  the next byte repeats n - 0x80 + 2 times
+
+and the packed form is kept when it is smaller than the raw pages.
+
+Writes src/icon_tiles.h and src/icon_tiles.cpp. PlatformIO runs this before
+every build (extra_scripts in platformio.ini) and it only rewrites them when
+icon.h is newer; it also runs standalone:
+
+    python tools/xbm2tiles.py
+"""
+
+import os
+import re
+import sys
+
+BANNER = [
+    "/* ____________________________",
+    "   This software is licensed under the MIT License:",
+    "   https://github.com/cifertech/nrfbox",
+    "   ________________________________________ */",
+    "",
+    "// Generated by tools/xbm2tiles.py from icon.h, do not edit",
+]
+
+BITMAP = re.compile(
+    r"//\s*'[^']*',\s*(\d+)x(\d+)px\s*\n"
+    r"\s*const unsigned char\s+(\w+)\s*\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}",
+    re.M)
+
+MAX_LITERAL = 128
+MAX_REPEAT = 129
+
+
+def parse(text):
+    for m in BITMAP.finditer(text):
+        width, height, name, body = int(m.group(1)), int(m.group(2)), m.group(3), m.group(4)
+        data = [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", body)]
+        if len(data) < (width + 7) // 8 * height:
+            sys.exit("xbm2tiles: %s is shorter than %dx%d" % (name, width, height))
+        yield name, width, height, data
+
+
+def to_pages(width, height, xbm):
+    stride = (width + 7) // 8
+    pages = (height + 7) // 8
+    out = []
+    for page in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and xbm[y * stride + x // 8] >> (x % 8) & 1:
+                    byte |= 1 << bit
+            out.append(byte)
+    return out
+
+
+def pack(data):
+    out = []
+    literal = []
+
+    def flush():
+        while literal:
+            chunk = literal[:MAX_LITERAL]
+            del literal[:MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < MAX_REPEAT and data[i + run] == data[i]:
+            run += 1
+        # a pair only pays as a run when no literal is open
+        if run >= 3 or (run == 2 and not literal):
+            flush()
+            out.extend((0x80 + run - 2, data[i]))
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return out
+
+
+def unpack(data):
+    out = []
+    i = 0
+    while i < len(data):
+        c = data[i]
+        if c < 0x80:
+            out.extend(data[i + 1:i + 2 + c])
+            i += 2 + c
+        else:
+            out.extend([data[i + 1]] * (c - 0x80 + 2))
+            i += 2
+    return out
+
+
+def tile_name(name):
+    return "tile_" + (name[len("bitmap_"):] if name.startswith("bitmap_") else name)
+
+
+def generate(text):
+    header = BANNER + [
+        "",
+        "#ifndef icon_tiles_H",
+        "#define icon_tiles_H",
+        "",
+        "#include \"tiles.h\"",
+        "",
+    ]
+    source = BANNER + [
+        "",
+        "#include <Arduino.h>",
+        "#include \"icon_tiles.h\"",
+        "#if !TILE_BLIT",
+        "#include \"icon.h\"",
+        "#endif",
+    ]
+    xbm_total = packed_total = 0
+    images = list(parse(text))
+    for name, width, height, xbm in images:
+        pages = to_pages(width, height, xbm)
+        packed = pack(pages)
+        assert unpack(packed) == pages, name
+        use_packed = len(packed) < len(pages)
+        stored = packed if use_packed else pages
+        xbm_total += (width + 7) // 8 * height
+        packed_total += len(stored)
+
+        tile = tile_name(name)
+        header.append("%-48s// %dx%d" % ("extern const TileImage %s;" % tile, width, height))
+        source.append("")
+        source.append("// '%s', %dx%d, %d B as XBM, %d B %s"
+                      % (name, width, height, (width + 7) // 8 * height, len(stored),
+                         "packed" if use_packed else "raw"))
+        source.append("static const uint8_t %s_data [] PROGMEM = {" % tile)
+        for i in range(0, len(stored), 16):
+            source.append("  " + ", ".join("0x%02x" % b for b in stored[i:i + 16]) + ",")
+        source.append("};")
+        source.append("const TileImage %s = { %d, %d, %d, %s_data, TILE_XBM(%s) };"
+                      % (tile, width, height, len(packed) if use_packed else 0, tile, name))
+
+    header += ["", "#endif"]
+    summary = "%d bitmaps, %d B as XBM, %d B stored" % (len(images), xbm_total, packed_total)
+    source.insert(len(BANNER), "// %s" % summary)
+    return header, source, summary
+
+
+def write(path, lines):
+    with open(path, "w", newline="") as f:
+        f.write("\r\n".join(lines) + "\r\n")
+
+
+def run(src_dir, force=False):
+    source = os.path.join(src_dir, "icon.h")
+    targets = [os.path.join(src_dir, "icon_tiles.h"), os.path.join(src_dir, "icon_tiles.cpp")]
+    if not force and all(os.path.exists(t) and os.path.getmtime(t) >= os.path.getmtime(source)
+                         for t in targets):
+        return
+    with open(source, newline="") as f:
+        text = f.read().replace("\r\n", "\n")
+    header, body, summary = generate(text)
+    write(targets[0], header)
+    write(targets[1], body)
+    print("xbm2tiles: %s" % summary)
+
+
+try:
+    Import("env")  # noqa: F821, defined when SCons runs this as an extra script
+    run(env.subst("$PROJECT_SRC_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        run(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"), force=True)